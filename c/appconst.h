@@ -7,14 +7,6 @@ All rights reserved.
 See the LICENSE.TXT file for licensing information.
 */
 
-// When PROFILE is defined, prints out run-time stats on a number of subordinate
-// routines in the embedder
-
-//#define PROFILE
-#ifdef PROFILE
-#include "platformTime.h"
-#endif
-
 /* Define DEBUG to get additional debugging. The default is to define it when MSC does */
 
 #ifdef _DEBUG
@@ -28,6 +20,42 @@ See the LICENSE.TXT file for licensing information.
 #undef SPEED_MACROS
 #endif
 
+/* Define EMBEDCOUNTERS to count hot path events of the edge addition embedder
+   into the embedding statistics of each graph (see gp_GetEmbedStats()).
+   When it is not defined, the counting statements compile to nothing. */
+
+//#define EMBEDCOUNTERS
+
+/* Define EMBEDTRACE to record trace events of the edge addition embedder
+   into the trace buffer of each graph for which gp_EnableTrace() was
+   called.  When it is not defined, the tracing statements compile to
+   nothing, and gp_EnableTrace() fails. */
+
+//#define EMBEDTRACE
+
+/* Define EDGE_SOA to store the members of the edge records of a graph as
+   separate arrays rather than as an array of edgeRec structures (see
+   graphStructures.h).  The edge accessor macros work the same either way. */
+
+//#define EDGE_SOA
+
+/* Define VERTEX_HOTREC to keep the vertex links, the external face links
+   and the vertexInfo members read by each Walkup and Walkdown step in one
+   cache line aligned record per vertex (see vertexHotRec).  The vertex
+   accessor macros work the same either way. */
+
+//#define VERTEX_HOTREC
+
+/* Define NARROW_INDEX to store the vertex and edge indices of the graph
+   structures and list collections as 16-bit graphIndex values rather than
+   ints, and their flags as 16-bit graphFlags.  This halves the size of the
+   vertex, edge and list node records for graphs small enough that all of
+   their indices fit (see GRAPHINDEX_MAX); gp_InitGraph() and
+   gp_EnsureArcCapacity() fail for larger graphs.  Bits 16 and higher of the
+   vertex and edge flags are then not available to applications. */
+
+//#define NARROW_INDEX
+
 /* Return status values; OK/NOTOK behave like Boolean true/false,
    not like program exit codes. */
 
@@ -63,6 +91,27 @@ extern int debugNOTOK();
 //#define NIL		-1
 //#define NIL_CHAR	0xFF
 
+/* The type of the vertex and edge indices stored in the graph structures,
+   the largest index it can hold, and the type of the vertex and edge flags.
+   There is no build with a 64-bit graphIndex, since the library functions
+   take and return vertex and edge indices as ints, so GRAPHINDEX_MAX of the
+   int build, about 2^31 arcs, is also the limit of the API. */
+
+#ifdef NARROW_INDEX
+#if NIL == 0
+typedef unsigned short graphIndex;
+#define GRAPHINDEX_MAX  65535
+#else
+typedef short graphIndex;
+#define GRAPHINDEX_MAX  32767
+#endif
+typedef unsigned short graphFlags;
+#else
+typedef int graphIndex;
+#define GRAPHINDEX_MAX  2147483647
+typedef unsigned graphFlags;
+#endif
+
 /* Defines fopen strings for reading and writing text files on PC and UNIX */
 
 #ifdef WINDOWS
@@ -20,6 +20,7 @@ extern "C" {
 ///////////////////////////////////////////////////////////////////////////////
 
 graphP	gp_New(void);
+graphP	gp_NewWithAllocator(graphAllocatorP theAllocator);
 
 int		gp_InitGraph(graphP theGraph, int N);
 void	gp_ReinitializeGraph(graphP theGraph);
@@ -32,6 +33,10 @@ int		gp_CreateRandomGraphEx(graphP theGraph, int numEdges);
 
 void	gp_Free(graphP *pGraph);
 
+graphP	gp_PoolAcquire(int N, int arcCapacity, int algorithm);
+void	gp_PoolRelease(graphP *pGraph);
+void	gp_PoolClear(void);
+
 int		gp_Read(graphP theGraph, char *FileName);
 #define WRITE_ADJLIST   1
 #define WRITE_ADJMATRIX 2
@@ -46,6 +51,31 @@ int		gp_GetVertexOutDegree(graphP theGraph, int v);
 
 int		gp_GetArcCapacity(graphP theGraph);
 int		gp_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
+int		gp_Trim(graphP theGraph);
+
+int		gp_GetMemoryUsage(graphP theGraph, graphMemoryUsageP pUsage);
+
+/* Flags for gp_SetAllocFlags(), which select how gp_InitGraph() allocates
+   the arrays of the graph and of its extensions (see graphArena.c) */
+
+#define ALLOCFLAGS_ARENA        1
+#define ALLOCFLAGS_HUGEPAGES    (2|ALLOCFLAGS_ARENA)
+#define ALLOCFLAGS_FILEBACKED   (4|ALLOCFLAGS_ARENA)
+
+int		gp_SetAllocFlags(graphP theGraph, int allocFlags);
+int		gp_GetAllocFlags(graphP theGraph);
+int		gp_SetArenaDirectory(graphP theGraph, char *dirName);
+
+int		gp_SetAllocator(graphAllocatorP theAllocator);
+void	gp_GetAllocator(graphAllocatorP theAllocator);
+
+void   *gp_AllocMemory(graphP theGraph, size_t size);
+void   *gp_ReallocMemory(graphP theGraph, void *memory, size_t size);
+void	gp_FreeMemory(graphP theGraph, void *memory);
+listCollectionP gp_NewListCollection(graphP theGraph, int N);
+void	gp_FreeListCollection(graphP theGraph, listCollectionP *pListColl);
+stackP	gp_NewStack(graphP theGraph, stackIndex capacity);
+void	gp_FreeStack(graphP theGraph, stackP *pStack);
 
 int		gp_AddEdge(graphP theGraph, int u, int ulink, int v, int vlink);
 int     gp_InsertEdge(graphP theGraph, int u, int e_u, int e_ulink,
@@ -68,6 +98,34 @@ int		gp_PreprocessForEmbedding(graphP theGraph);
 int		gp_Embed(graphP theGraph, int embedFlags);
 int		gp_TestEmbedResultIntegrity(graphP theGraph, graphP origGraph, int embedResult);
 
+/* Options for gp_SetEmbedOptions(), which select optional passes of gp_Embed() */
+
+#define EMBEDOPTIONS_COMPACTARCS    1
+
+int		gp_SetEmbedOptions(graphP theGraph, int embedOptions);
+int		gp_GetEmbedOptions(graphP theGraph);
+
+int		gp_GetEmbedStats(graphP theGraph, embedStatsP pStats);
+void	gp_ClearEmbedStats(graphP theGraph);
+void	gp_SetEmbedPhaseObserver(graphP theGraph, embedPhaseObserver fpObserver, void *context);
+
+int		gp_EnableTrace(graphP theGraph, int capacity);
+void	gp_ClearTrace(graphP theGraph);
+int		gp_WriteTrace(graphP theGraph, char *FileName);
+
+/* The binary trace file written by gp_WriteTrace() has this header,
+   followed by the numRecorded events, oldest first */
+
+#define TRACEFILE_MAGIC     0x52544C50
+#define TRACEFILE_VERSION   1
+
+typedef struct
+{
+	unsigned int magic, version, eventSize, capacity;
+	unsigned long long numEvents;
+	unsigned int numRecorded, reserved;
+} traceFileHeader;
+
 /* Possible Flags for gp_Embed.  The planar and outerplanar settings are supported
    natively.  The rest require extension modules. */
 
@@ -0,0 +1,602 @@
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+#define GRAPHARENA_C
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+#endif
+
+#include "graph.h"
+
+/********************************************************************
+ Allocators
+
+ All memory of a graph and of its extensions that is not carved from
+ its arena, including the graph record itself, is allocated with the
+ allocator of the graph, which is copied from the default allocator
+ by gp_New(), given to gp_NewWithAllocator(), or inherited from the
+ original by gp_DupGraph().  The default allocator is the C library,
+ unless the host replaces it with gp_SetAllocator(), for example to
+ route the memory of graphs to its own arenas or pools.  The arena
+ itself is always reserved from the virtual memory of the process.
+
+ A graph keeps its allocator for its whole life, so memory is always
+ freed by the allocator that allocated it.  The allocator of a graph
+ is only called by the thread using the graph, so an allocator need
+ not be thread safe if each thread uses its own, such as one arena
+ per thread.  gp_SetAllocator() is not synchronized with gp_New(), so
+ it should be called before other threads create graphs.
+ ********************************************************************/
+
+static void *_CLibAlloc(void *context, size_t size)
+{
+     (void) context;
+     return malloc(size);
+}
+
+static void *_CLibRealloc(void *context, void *memory, size_t size)
+{
+     (void) context;
+     return realloc(memory, size);
+}
+
+static void _CLibFree(void *context, void *memory)
+{
+     (void) context;
+     free(memory);
+}
+
+static graphAllocator defaultAllocator = { _CLibAlloc, _CLibRealloc, _CLibFree, NULL };
+
+#define _GetAllocator(theGraph) ((theGraph) != NULL ? &(theGraph)->allocator : &defaultAllocator)
+
+/********************************************************************
+ Arena allocation
+
+ By default, each array of a graph and of its extensions is allocated
+ separately.  If ALLOCFLAGS_ARENA is set with gp_SetAllocFlags(), then
+ gp_InitGraph() reserves one arena from which the arrays are carved by
+ gp_AllocMemory(), gp_NewListCollection() and gp_NewStack(), and the
+ arena is released in one piece when the graph is cleared by gp_Free().
+ With ALLOCFLAGS_HUGEPAGES, the arena is also aligned to huge pages and
+ advised to be backed by transparent huge pages, where supported, which
+ reduces the TLB misses of the embedder on large graphs.
+
+ With ALLOCFLAGS_FILEBACKED, the arena is instead mapped from a sparse
+ file, so that graphs larger than memory can be embedded out of core,
+ with the kernel paging the arrays to and from the file as they are
+ used.  The file is created in the directory given to
+ gp_SetArenaDirectory(), or else in $TMPDIR, or else in /var/tmp, and
+ is unlinked at once, so its blocks are released when the arena is,
+ even if the process ends abnormally.
+
+ The blocks that the core arrays will occupy are allocated in the file
+ when the arena is created, with posix_fallocate() where supported, and
+ if the file system has no room for them, the arena is not created and
+ the graph is allocated in memory instead.  The rest of the reservation
+ is left sparse and takes space only as it is written.  Writing to a
+ page of a shared file mapping for which the file system has no room
+ raises SIGBUS, so if the file system fills up, the process is ended
+ by a write to memory carved from the sparse part, such as the arrays
+ of an extension attached after gp_InitGraph() or an edge array regrown
+ by gp_EnsureArcCapacity(), or by any write on a file system that
+ cannot preallocate.  The arena directory should therefore be on a
+ file system with room for a few times the size of the graph, which is
+ reported by gp_GetMemoryUsage().
+
+ The edge records, which the embedder visits in the order of the
+ adjacency lists, are advised to be accessed randomly, so that a page
+ fault does not read ahead, while the vertex arrays, which the embedder
+ mostly visits in order of DFI, keep the default read ahead.  Huge
+ pages are not used for the file, and on Windows, the arena is kept in
+ memory.
+
+ The throughput of the embedder on a file-backed arena depends on how
+ much of the graph stays resident.  When the whole graph fits in
+ memory, the arrays stay in the page cache, and gp_Embed() runs within
+ about 10% of an in-memory arena (planarity-bench -alloc file, on
+ graphs of a million vertices), the difference being the writeback of
+ dirty pages to the file.  Once the graph exceeds memory, each page
+ fault costs a read from storage, so the throughput follows the
+ storage, and is expected to drop by one to two orders of magnitude on
+ SSDs, and more on disks.  Embedding a graph whose vertices were
+ numbered in a DFS order and whose arcs are compacted
+ (EMBEDOPTIONS_COMPACTARCS) keeps the page faults closest to sequential.
+
+ The arena is reserved from the virtual memory of the process at a few
+ times the size of the core arrays, so that the arrays of extensions
+ attached before or after gp_InitGraph() also fit.  Pages are only
+ committed as they are used: on Windows, as the arrays are carved from
+ the arena, and elsewhere, as they are first written.  Requests that
+ do not fit, or whose pages cannot be committed, fall back to
+ the allocator of the graph, as do all requests made before
+ gp_InitGraph(), and if the arena cannot be reserved, the graph is
+ allocated as if without it.
+
+ Extensions should allocate their per-vertex and per-edge arrays with
+ these functions, passing their graph, and release them with
+ gp_FreeMemory(), gp_FreeListCollection() and gp_FreeStack(), which
+ do nothing for memory carved from the arena.  Memory freed from the
+ arena is not reused, so _EnsureArcCapacity() leaves the prior edge
+ array in the arena until the graph is freed.
+ ********************************************************************/
+
+#define ARENA_ALIGNMENT         64
+#define ARENA_HUGEPAGESIZE      (2*1024*1024)
+#define ARENA_RESERVEFACTOR     4
+
+#define _AlignUp(size, alignment) (((size) + (alignment) - 1) & ~((size_t) (alignment) - 1))
+
+#define ARENA_FILEDIR            "/var/tmp"
+#define ARENA_FILENAME          "planarity.XXXXXX"
+
+int  _CreateArena(graphP theGraph, int N);
+void _FreeArena(graphP theGraph);
+static int _CommitArenaMemory(void *memory, size_t size);
+int  _IsInArena(graphP theGraph, void *memory);
+void _AdviseRandomAccess(graphP theGraph, void *memory, size_t size);
+
+/********************************************************************
+ gp_SetAllocator()
+ Sets the default allocator, which gp_New() gives to the graphs that
+ it creates, or restores the C library if theAllocator is NULL.  The
+ allocator is copied, and existing graphs keep their own allocators.
+
+ Returns OK, or NOTOK if any of the functions of theAllocator is NULL
+ ********************************************************************/
+
+int  gp_SetAllocator(graphAllocatorP theAllocator)
+{
+     if (theAllocator == NULL)
+     {
+         defaultAllocator.fpAlloc = _CLibAlloc;
+         defaultAllocator.fpRealloc = _CLibRealloc;
+         defaultAllocator.fpFree = _CLibFree;
+         defaultAllocator.context = NULL;
+         return OK;
+     }
+
+     if (theAllocator->fpAlloc == NULL || theAllocator->fpRealloc == NULL ||
+         theAllocator->fpFree == NULL)
+         return NOTOK;
+
+     defaultAllocator = *theAllocator;
+     return OK;
+}
+
+/********************************************************************
+ gp_GetAllocator()
+ Copies the default allocator into theAllocator.
+ ********************************************************************/
+
+void gp_GetAllocator(graphAllocatorP theAllocator)
+{
+     if (theAllocator != NULL)
+         *theAllocator = defaultAllocator;
+}
+
+/********************************************************************
+ gp_SetAllocFlags()
+ Sets the ALLOCFLAGS (see graph.h) used by gp_InitGraph() to allocate
+ the arrays of theGraph.  The flags persist through gp_InitGraph()
+ failures and are inherited by gp_DupGraph().
+
+ Returns OK, or NOTOK if gp_InitGraph() has already been called
+ ********************************************************************/
+
+int  gp_SetAllocFlags(graphP theGraph, int allocFlags)
+{
+     if (theGraph == NULL || theGraph->N != 0)
+         return NOTOK;
+
+     theGraph->arena.allocFlags = allocFlags;
+     return OK;
+}
+
+/********************************************************************
+ gp_GetAllocFlags()
+ ********************************************************************/
+
+int  gp_GetAllocFlags(graphP theGraph)
+{
+     return theGraph == NULL ? 0 : theGraph->arena.allocFlags;
+}
+
+/********************************************************************
+ gp_SetArenaDirectory()
+ Sets the directory in which gp_InitGraph() creates the file of an
+ ALLOCFLAGS_FILEBACKED arena for theGraph, or restores the default if
+ dirName is NULL.  The name is copied, persists through gp_InitGraph()
+ failures and is inherited by gp_DupGraph().
+
+ The file system of the directory must have room for the graph: the
+ core arrays are preallocated in the file, but the rest of the arena
+ is sparse, and a write to it when the file system is full ends the
+ process with SIGBUS (see Arena allocation above).
+
+ Returns OK, or NOTOK if gp_InitGraph() has already been called or on
+ failure to copy the name
+ ********************************************************************/
+
+int  gp_SetArenaDirectory(graphP theGraph, char *dirName)
+{
+char *newDirName = NULL;
+
+     if (theGraph == NULL || theGraph->N != 0)
+         return NOTOK;
+
+     if (dirName != NULL)
+     {
+         if ((newDirName = (char *) gp_ReallocMemory(theGraph, NULL, strlen(dirName) + 1)) == NULL)
+             return NOTOK;
+         strcpy(newDirName, dirName);
+     }
+
+     gp_FreeMemory(theGraph, theGraph->arena.dirName);
+     theGraph->arena.dirName = newDirName;
+     return OK;
+}
+
+/********************************************************************
+ gp_AllocMemory()
+ Returns size bytes of uninitialized memory, carved from the arena of
+ theGraph if it has one with enough room, or from the allocator of
+ theGraph otherwise, or NULL on failure.  If theGraph is NULL, the
+ default allocator is used.  Release the memory with gp_FreeMemory().
+ ********************************************************************/
+
+void *gp_AllocMemory(graphP theGraph, size_t size)
+{
+void *memory;
+
+     if (theGraph != NULL && theGraph->arena.base != NULL &&
+         theGraph->arena.size - theGraph->arena.used >= size &&
+         _CommitArenaMemory(theGraph->arena.base + theGraph->arena.used, size) == OK)
+     {
+         memory = theGraph->arena.base + theGraph->arena.used;
+         theGraph->arena.used += _AlignUp(size, ARENA_ALIGNMENT);
+         if (theGraph->arena.used > theGraph->arena.size)
+             theGraph->arena.used = theGraph->arena.size;
+         return memory;
+     }
+
+     return _GetAllocator(theGraph)->fpAlloc(_GetAllocator(theGraph)->context, size);
+}
+
+/********************************************************************
+ gp_ReallocMemory()
+ Resizes memory obtained from the allocator of theGraph, as realloc()
+ does.  The memory is never carved from the arena, so with memory NULL,
+ this allocates the temporary buffers of an algorithm and the strings
+ returned to the caller, which are then released with gp_FreeMemory().
+
+ Returns the resized memory, or NULL on failure or if memory was carved
+ from the arena, which cannot be resized, in which cases memory is kept
+ ********************************************************************/
+
+void *gp_ReallocMemory(graphP theGraph, void *memory, size_t size)
+{
+     if (memory != NULL && _IsInArena(theGraph, memory))
+         return NULL;
+
+     return _GetAllocator(theGraph)->fpRealloc(_GetAllocator(theGraph)->context, memory, size);
+}
+
+/********************************************************************
+ gp_FreeMemory()
+ Frees memory obtained from gp_AllocMemory() or gp_ReallocMemory(),
+ unless it was carved from the arena, which is only released as a
+ whole by gp_Free().
+ ********************************************************************/
+
+void gp_FreeMemory(graphP theGraph, void *memory)
+{
+     if (memory != NULL && !_IsInArena(theGraph, memory))
+         _GetAllocator(theGraph)->fpFree(_GetAllocator(theGraph)->context, memory);
+}
+
+/********************************************************************
+ gp_NewListCollection()
+ gp_FreeListCollection()
+ LCNew() and LCFree() for the list collections of theGraph, which are
+ made in one block of memory from gp_AllocMemory().
+ ********************************************************************/
+
+listCollectionP gp_NewListCollection(graphP theGraph, int N)
+{
+void *memory;
+
+     if (N <= 0)
+         return NULL;
+
+     if ((memory = gp_AllocMemory(theGraph, LCSizeOf(N))) == NULL)
+         return NULL;
+
+     return LCNewAt(memory, N);
+}
+
+void gp_FreeListCollection(graphP theGraph, listCollectionP *pListColl)
+{
+     if (pListColl == NULL || *pListColl == NULL)
+         return;
+
+     gp_FreeMemory(theGraph, *pListColl);
+     *pListColl = NULL;
+}
+
+/********************************************************************
+ gp_NewStack()
+ gp_FreeStack()
+ sp_New() and sp_Free() for the stacks of theGraph, which are made in
+ one block of memory from gp_AllocMemory().
+ ********************************************************************/
+
+stackP gp_NewStack(graphP theGraph, stackIndex capacity)
+{
+void *memory;
+
+     if ((memory = gp_AllocMemory(theGraph, sp_SizeOf(capacity))) == NULL)
+         return NULL;
+
+     return sp_NewAt(memory, capacity);
+}
+
+void gp_FreeStack(graphP theGraph, stackP *pStack)
+{
+     if (pStack == NULL || *pStack == NULL)
+         return;
+
+     gp_FreeMemory(theGraph, *pStack);
+     *pStack = NULL;
+}
+
+/********************************************************************
+ _CommitArenaMemory()
+ Commits the pages of the size bytes of memory being carved from an
+ arena.  On Windows, the arena is only reserved, so the pages must be
+ committed before use; elsewhere, they are committed when written.
+
+ Returns OK, or NOTOK if the pages cannot be committed
+ ********************************************************************/
+
+static int _CommitArenaMemory(void *memory, size_t size)
+{
+#ifdef WIN32
+     if (size > 0 && VirtualAlloc(memory, size, MEM_COMMIT, PAGE_READWRITE) == NULL)
+         return NOTOK;
+#else
+     (void) memory;
+     (void) size;
+#endif
+     return OK;
+}
+
+#ifndef WIN32
+/********************************************************************
+ _PreallocateArenaFile()
+ Allocates the blocks of the first size bytes of the arena file fd, so
+ that a file system without room for them is reported now rather than
+ by SIGBUS when the mapped pages are written.
+
+ Returns OK, or NOTOK if the file system has no room.  If the file
+ system cannot preallocate, the file is left sparse and OK is returned.
+ ********************************************************************/
+
+static int _PreallocateArenaFile(int fd, size_t size)
+{
+#if defined(_POSIX_ADVISORY_INFO) && _POSIX_ADVISORY_INFO > 0
+int  result = posix_fallocate(fd, 0, (off_t) size);
+
+     if (result != 0 && result != EINVAL && result != EOPNOTSUPP)
+         return NOTOK;
+#endif
+     return OK;
+}
+
+/********************************************************************
+ _MapArenaFile()
+ Maps size bytes of a new file, which is unlinked at once, in the
+ arena directory of theGraph (see gp_SetArenaDirectory()).  The first
+ coreSize bytes are preallocated and the rest is sparse.
+
+ Returns the mapped memory, or MAP_FAILED on failure
+ ********************************************************************/
+
+static char *_MapArenaFile(graphP theGraph, size_t size, size_t coreSize)
+{
+char *dirName = theGraph->arena.dirName, *fileName;
+char *base = (char *) MAP_FAILED;
+int  fd;
+
+     if (dirName == NULL && (dirName = getenv("TMPDIR")) == NULL)
+         dirName = ARENA_FILEDIR;
+
+     fileName = (char *) gp_ReallocMemory(theGraph, NULL, strlen(dirName) + sizeof(ARENA_FILENAME) + 1);
+     if (fileName == NULL)
+         return base;
+     sprintf(fileName, "%s/%s", dirName, ARENA_FILENAME);
+
+     if ((fd = mkstemp(fileName)) >= 0)
+     {
+         unlink(fileName);
+
+         // Extending the file leaves it sparse, so only the core arrays
+         // take space in the file system until the rest is written
+         if (ftruncate(fd, (off_t) size) == 0 && _PreallocateArenaFile(fd, coreSize) == OK)
+             base = (char *) mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+         // The mapping keeps the file open
+         close(fd);
+     }
+
+     gp_FreeMemory(theGraph, fileName);
+     return base;
+}
+#endif
+
+/********************************************************************
+ _CreateArena()
+ Called by gp_InitGraph() before any arrays are allocated for a graph
+ of N vertices, to reserve an arena if the ALLOCFLAGS ask for one.
+ The arc capacity is the one that _InitGraph() will use.
+
+ Returns OK, or NOTOK if the arena cannot be reserved
+ ********************************************************************/
+
+int  _CreateArena(graphP theGraph, int N)
+{
+size_t arcCapacity, coreSize, size, slop = 0;
+char *base;
+graphExtensionP extension;
+int K;
+
+     if (!(theGraph->arena.allocFlags & ALLOCFLAGS_ARENA) || theGraph->arena.base != NULL)
+         return OK;
+
+     // The core arrays: V, VI, extFace, E, the list collections and stacks
+     arcCapacity = theGraph->arcCapacity > 0 ? theGraph->arcCapacity : 2*DEFAULT_EDGE_LIMIT*N;
+     coreSize = (size_t) (2*N + 1) * (sizeof(vertexRec) + sizeof(extFaceLinkRec)) +
+                (size_t) (N + 1) * (sizeof(vertexInfo) + 2*sizeof(lcnode)) +
+                (size_t) (arcCapacity + 2) * (sizeof(edgeRec) + 3*sizeof(int)) +
+                (size_t) 6*N*sizeof(int) + 8*ARENA_ALIGNMENT;
+#ifdef VERTEX_HOTREC
+     coreSize += (size_t) (2*N + 1) * sizeof(vertexHotRec);
+#endif
+
+     // The columns that the extensions have declared so far
+     for (extension = theGraph->extensions; extension != NULL;
+          extension = (graphExtensionP) extension->next)
+     {
+         for (K = 0; K < extension->numColumns; K++)
+             coreSize += extension->columns[K].recordSize *
+                         ((extension->columns[K].columnFlags & COLUMNFLAGS_EDGE) ? arcCapacity + 2 : (size_t) N + 1) +
+                         ARENA_ALIGNMENT;
+     }
+
+     size = _AlignUp(ARENA_RESERVEFACTOR * coreSize, ARENA_ALIGNMENT);
+
+#ifdef WIN32
+     if ((base = (char *) VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_READWRITE)) == NULL)
+         return NOTOK;
+#else
+     if ((theGraph->arena.allocFlags & ALLOCFLAGS_FILEBACKED) == ALLOCFLAGS_FILEBACKED)
+     {
+         if ((base = _MapArenaFile(theGraph, size, coreSize)) == (char *) MAP_FAILED)
+             return NOTOK;
+
+         theGraph->arena.base = base;
+         theGraph->arena.size = size;
+         theGraph->arena.used = 0;
+         return OK;
+     }
+
+     if ((theGraph->arena.allocFlags & ALLOCFLAGS_HUGEPAGES) == ALLOCFLAGS_HUGEPAGES)
+     {
+         size = _AlignUp(size, ARENA_HUGEPAGESIZE);
+         slop = ARENA_HUGEPAGESIZE;
+     }
+
+     base = (char *) mmap(NULL, size + slop, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+     if (base == (char *) MAP_FAILED)
+         return NOTOK;
+
+     // Trim the reservation to a huge page aligned arena
+     if (slop > 0)
+     {
+         size_t lead = _AlignUp((size_t) base, ARENA_HUGEPAGESIZE) - (size_t) base;
+
+         if (lead > 0)
+             munmap(base, lead);
+         if (slop - lead > 0)
+             munmap(base + lead + size, slop - lead);
+         base += lead;
+
+#ifdef MADV_HUGEPAGE
+         madvise(base, size, MADV_HUGEPAGE);
+#endif
+     }
+#endif
+
+     theGraph->arena.base = base;
+     theGraph->arena.size = size;
+     theGraph->arena.used = 0;
+     return OK;
+}
+
+/********************************************************************
+ _FreeArena()
+ Releases the arena of theGraph, if any, in one call.  The flags are
+ kept so that a later gp_InitGraph() creates a new arena.
+ ********************************************************************/
+
+void _FreeArena(graphP theGraph)
+{
+     if (theGraph->arena.base != NULL)
+     {
+#ifdef WIN32
+         VirtualFree(theGraph->arena.base, 0, MEM_RELEASE);
+#else
+         munmap(theGraph->arena.base, theGraph->arena.size);
+#endif
+         theGraph->arena.base = NULL;
+     }
+
+     theGraph->arena.size = theGraph->arena.used = 0;
+}
+
+/********************************************************************
+ _IsInArena()
+ ********************************************************************/
+
+int  _IsInArena(graphP theGraph, void *memory)
+{
+     return theGraph != NULL && theGraph->arena.base != NULL &&
+            (char *) memory >= theGraph->arena.base &&
+            (char *) memory < theGraph->arena.base + theGraph->arena.size;
+}
+
+/********************************************************************
+ _AdviseRandomAccess()
+ Advises that the pages wholly within the size bytes of memory will be
+ accessed in no particular order, if memory was carved from the arena
+ of theGraph and the arena is file-backed, so that page faults on them
+ do not read ahead from the file.
+ ********************************************************************/
+
+void _AdviseRandomAccess(graphP theGraph, void *memory, size_t size)
+{
+#if !defined(WIN32) && defined(MADV_RANDOM)
+size_t pageSize, start, end;
+
+     if ((theGraph->arena.allocFlags & ALLOCFLAGS_FILEBACKED) != ALLOCFLAGS_FILEBACKED ||
+         memory == NULL || !_IsInArena(theGraph, memory))
+         return;
+
+     pageSize = (size_t) sysconf(_SC_PAGESIZE);
+     start = _AlignUp((size_t) memory, pageSize);
+     end = ((size_t) memory + size) & ~(pageSize - 1);
+
+     if (start < end)
+         madvise((void *) start, end - start, MADV_RANDOM);
+#endif
+}
@@ -8,7 +8,7 @@ See the LICENSE.TXT file for licensing information.
 
 #include "graph.h"
 
-extern void _ClearVertexVisitedFlags(graphP theGraph, int);
+extern void _ClearVertexVisitedFlags(graphP theGraph);
 
 /********************************************************************
  gp_CreateDFSTree
@@ -24,19 +24,12 @@ extern void _ClearVertexVisitedFlags(graphP theGraph, int);
  up related data structures at the same time as the DFS tree is created.
  ********************************************************************/
 
-#include "platformTime.h"
-
 int  gp_CreateDFSTree(graphP theGraph)
 {
 stackP theStack;
 int N, DFI, v, uparent, u, e;
 
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
-
-     if (theGraph==NULL) return NOTOK;
+     if (theGraph==NULL || gp_IsTrimmed(theGraph)) return NOTOK;
      if (theGraph->internalFlags & FLAGS_DFSNUMBERED) return OK;
 
      gp_LogLine("\ngraphDFSUtils.c/gp_CreateDFSTree() start");
@@ -49,12 +42,12 @@ platform_GetTime(start);
         This is already in theGraph structure, so we make sure it's empty,
         then clear all visited flags in prep for the Depth first search. */
 
-     if (sp_GetCapacity(theStack) < 2*gp_GetArcCapacity(theGraph))
+     if (sp_GetCapacity(theStack) < 2 * (stackIndex) gp_GetArcCapacity(theGraph))
     	 return NOTOK;
 
      sp_ClearStack(theStack);
 
-     _ClearVertexVisitedFlags(theGraph, FALSE);
+     _ClearVertexVisitedFlags(theGraph);
 
 /* This outer loop causes the connected subgraphs of a disconnected
         graph to be numbered */
@@ -108,11 +101,6 @@ platform_GetTime(start);
 
      theGraph->internalFlags |= FLAGS_DFSNUMBERED;
 
-#ifdef PROFILE
-platform_GetTime(end);
-printf("DFS in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
-
      return OK;
 }
 
@@ -134,6 +122,8 @@ printf("DFS in %.3lf seconds.\n", platform_GetDuration(start,end));
 
 int  gp_SortVertices(graphP theGraph)
 {
+     if (theGraph == NULL || gp_IsTrimmed(theGraph)) return NOTOK;
+
      return theGraph->functions.fpSortVertices(theGraph);
 }
 
@@ -141,11 +131,6 @@ int  _SortVertices(graphP theGraph)
 {
 int  v, EsizeOccupied, e, srcPos, dstPos;
 
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
-
      if (theGraph == NULL) return NOTOK;
      if (!(theGraph->internalFlags&FLAGS_DFSNUMBERED))
          if (gp_CreateDFSTree(theGraph) != OK)
@@ -181,7 +166,7 @@ platform_GetTime(start);
         location, so we cannot use index==v as a test for whether the
         correct vertex is in location 'index'. */
 
-     _ClearVertexVisitedFlags(theGraph, FALSE);
+     _ClearVertexVisitedFlags(theGraph);
 
      /* We visit each vertex location, skipping those marked as visited since
         we've already moved the correct vertex into that location. The
@@ -213,11 +198,6 @@ platform_GetTime(start);
 
 	 gp_LogLine("graphDFSUtils.c/_SortVertices() end\n");
 
-#ifdef PROFILE
-platform_GetTime(end);
-printf("SortVertices in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
-
      return OK;
 }
 
@@ -248,10 +228,12 @@ printf("SortVertices in %.3lf seconds.\n", platform_GetDuration(start,end));
 
 int  gp_LowpointAndLeastAncestor(graphP theGraph)
 {
-stackP theStack = theGraph->theStack;
+stackP theStack;
 int v, u, uneighbor, e, L, leastAncestor;
 
-	 if (theGraph == NULL) return NOTOK;
+	 if (theGraph == NULL || gp_IsTrimmed(theGraph)) return NOTOK;
+
+	 theStack = theGraph->theStack;
 
 	 if (!(theGraph->internalFlags&FLAGS_DFSNUMBERED))
 		 if (gp_CreateDFSTree(theGraph) != OK)
@@ -261,11 +243,6 @@ int v, u, uneighbor, e, L, leastAncestor;
     	 if (gp_SortVertices(theGraph) != OK)
     		 return NOTOK;
 
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
-
 	 gp_LogLine("\ngraphDFSUtils.c/gp_LowpointAndLeastAncestor() start");
 
 	 // A stack of size N suffices because at maximum every vertex is pushed only once
@@ -275,7 +252,7 @@ platform_GetTime(start);
 
      sp_ClearStack(theStack);
 
-     _ClearVertexVisitedFlags(theGraph, FALSE);
+     _ClearVertexVisitedFlags(theGraph);
 
      // This outer loop causes the connected subgraphs of a disconnected graph to be processed
      for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v);)
@@ -346,11 +323,6 @@ platform_GetTime(start);
 
 	 gp_LogLine("graphDFSUtils.c/gp_LowpointAndLeastAncestor() end\n");
 
-#ifdef PROFILE
-platform_GetTime(end);
-printf("Lowpoint in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
-
      return OK;
 }
 
@@ -388,11 +360,6 @@ int v, u, uneighbor, e, leastAncestor;
 		 if (gp_SortVertices(theGraph) != OK)
 			 return NOTOK;
 
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
-
 	 gp_LogLine("\ngraphDFSUtils.c/gp_LeastAncestor() start");
 
 	 // A stack of size N suffices because at maximum every vertex is pushed only once
@@ -444,10 +411,5 @@ platform_GetTime(start);
 
 	 gp_LogLine("graphDFSUtils.c/gp_LeastAncestor() end\n");
 
-#ifdef PROFILE
-platform_GetTime(end);
-printf("LeastAncestor in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
-
 	 return OK;
 }
@@ -189,7 +189,8 @@ int _ComputeVertexPositions(DrawPlanarContext *context)
 int _ComputeVertexPositionsInComponent(DrawPlanarContext *context, int root, int *pVertpos)
 {
 graphP theEmbedding = context->theGraph;
-listCollectionP theOrder = LCNew(gp_PrimaryVertexIndexBound(theEmbedding));
+listCollectionP theOrder = LCNewAt(gp_ReallocMemory(theEmbedding, NULL, LCSizeOf(gp_PrimaryVertexIndexBound(theEmbedding))),
+                                   gp_PrimaryVertexIndexBound(theEmbedding));
 int W, P, C, V, e;
 
     if (theOrder == NULL)
@@ -282,7 +283,7 @@ int W, P, C, V, e;
 
     // Clean up and return
 
-    LCFree(&theOrder);
+    gp_FreeMemory(theEmbedding, theOrder);
     return OK;
 }
 
@@ -344,7 +345,7 @@ int e, eTwin, eCur, v, vpos, epos, eIndex;
 
     // Sort the vertices by vertical position (in linear time)
 
-    if ((vertexOrder = (int *) malloc(theEmbedding->N * sizeof(int))) == NULL)
+    if ((vertexOrder = (int *) gp_ReallocMemory(theEmbedding, NULL, theEmbedding->N * sizeof(int))) == NULL)
         return NOTOK;
 
 	for (v = gp_GetFirstVertex(theEmbedding); gp_VertexInRange(theEmbedding, v); v++)
@@ -357,9 +358,11 @@ int e, eTwin, eCur, v, vpos, epos, eIndex;
     //    represented by a pair of adjacent edge records
     //    at index 2X.
 
-    if (theEmbedding->M > 0 && (edgeList = LCNew(gp_GetFirstEdge(theEmbedding)/2+theEmbedding->M)) == NULL)
+    if (theEmbedding->M > 0 &&
+        (edgeList = LCNewAt(gp_ReallocMemory(theEmbedding, NULL, LCSizeOf(gp_GetFirstEdge(theEmbedding)/2+theEmbedding->M)),
+                            gp_GetFirstEdge(theEmbedding)/2+theEmbedding->M)) == NULL)
     {
-        free(vertexOrder);
+        gp_FreeMemory(theEmbedding, vertexOrder);
         return NOTOK;
     }
 
@@ -489,8 +492,8 @@ int e, eTwin, eCur, v, vpos, epos, eIndex;
     }
 
     // Clean up and return
-    LCFree(&edgeList);
-    free(vertexOrder);
+    gp_FreeMemory(theEmbedding, edgeList);
+    gp_FreeMemory(theEmbedding, vertexOrder);
 
 	gp_LogLine("graphDrawPlanar.c/_ComputeEdgePositions() end\n");
 
@@ -778,7 +781,7 @@ int WPredNextLink = 1^WPrevLink,
  _RenderToString()
  Draws the previously calculated visibility representation in a
  string of size (M+1)*2N + 1 characters, which should be deallocated
- with free().
+ with gp_FreeMemory(theEmbedding, ...).
 
  Returns NULL on failure, or the string containing the visibility
  representation otherwise.  The string can be printed using %s,
@@ -795,7 +798,7 @@ char *_RenderToString(graphP theEmbedding)
         int M = theEmbedding->M;
         int zeroBasedVertexOffset = (theEmbedding->internalFlags & FLAGS_ZEROBASEDIO) ? gp_GetFirstVertex(theEmbedding) : 0;
         int n, m, EsizeOccupied, v, vRange, e, eRange, Mid, Pos;
-        char *visRep = (char *) malloc(sizeof(char) * ((M+1) * 2*N + 1));
+        char *visRep = (char *) gp_ReallocMemory(theEmbedding, NULL, sizeof(char) * ((M+1) * 2*N + 1));
         char numBuffer[32];
 
         if (visRep == NULL)
@@ -803,7 +806,7 @@ char *_RenderToString(graphP theEmbedding)
 
         if (sp_NonEmpty(context->theGraph->edgeHoles))
         {
-            free(visRep);
+            gp_FreeMemory(theEmbedding, visRep);
             return NULL;
         }
 
@@ -892,7 +895,7 @@ int gp_DrawPlanar_RenderToFile(graphP theEmbedding, char *theFileName)
         if (theRendition != NULL)
         {
             fprintf(outfile, "%s", theRendition);
-            free(theRendition);
+            gp_FreeMemory(theEmbedding, theRendition);
         }
 
         if (strcmp(theFileName, "stdout") == 0 || strcmp(theFileName, "stderr") == 0)
@@ -5,11 +5,12 @@ See the LICENSE.TXT file for licensing information.
 */
 
 #include <stdlib.h>
+#include <stddef.h>
 
 #include "graphDrawPlanar.private.h"
 #include "graphDrawPlanar.h"
 
-extern void _ClearVertexVisitedFlags(graphP theGraph, int);
+extern void _ClearVertexVisitedFlags(graphP theGraph);
 
 extern void _CollectDrawingData(DrawPlanarContext *context, int RootVertex, int W, int WPrevLink);
 extern int  _BreakTie(DrawPlanarContext *context, int BicompRoot, int W, int WPrevLink);
@@ -20,11 +21,11 @@ extern int  _CheckVisibilityRepresentationIntegrity(DrawPlanarContext *context);
 /* Forward declarations of local functions */
 
 void _DrawPlanar_ClearStructures(DrawPlanarContext *context);
-int  _DrawPlanar_CreateStructures(DrawPlanarContext *context);
-int  _DrawPlanar_InitStructures(DrawPlanarContext *context);
 
 void _DrawPlanar_InitEdgeRec(DrawPlanarContext *context, int v);
+void _DrawPlanar_InitEdgeColumnRec(void *pContext, int e);
 void _DrawPlanar_InitVertexInfo(DrawPlanarContext *context, int v);
+void _DrawPlanar_InitVertexColumnRec(void *pContext, int v);
 
 /* Forward declarations of overloading functions */
 
@@ -34,9 +35,6 @@ int  _DrawPlanar_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResul
 int  _DrawPlanar_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph);
 int  _DrawPlanar_CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
 
-int  _DrawPlanar_InitGraph(graphP theGraph, int N);
-void _DrawPlanar_ReinitializeGraph(graphP theGraph);
-int  _DrawPlanar_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
 int  _DrawPlanar_SortVertices(graphP theGraph);
 
 int  _DrawPlanar_ReadPostprocess(graphP theGraph, void *extraData, long extraDataSize);
@@ -46,11 +44,12 @@ int  _DrawPlanar_WritePostprocess(graphP theGraph, void **pExtraData, long *pExt
 
 void *_DrawPlanar_DupContext(void *pContext, void *theGraph);
 void _DrawPlanar_FreeContext(void *);
+size_t _DrawPlanar_GetMemoryUsage(void *);
 
 /****************************************************************************
  * DRAWPLANAR_ID - the variable used to hold the integer identifier for this
  * extension, enabling this feature's extension context to be distinguished
- * from other features' extension contexts that may be attached to a graph.
+ * from other features' extension contexts that may be attached to a graph.
  ****************************************************************************/
 
 int DRAWPLANAR_ID = 0;
@@ -87,7 +86,7 @@ int  gp_AttachDrawPlanar(graphP theGraph)
      }
 
      // Allocate a new extension context
-     context = (DrawPlanarContext *) malloc(sizeof(DrawPlanarContext));
+     context = (DrawPlanarContext *) gp_AllocMemory(theGraph, sizeof(DrawPlanarContext));
      if (context == NULL)
      {
          return NOTOK;
@@ -110,9 +109,6 @@ int  gp_AttachDrawPlanar(graphP theGraph)
      context->functions.fpCheckEmbeddingIntegrity = _DrawPlanar_CheckEmbeddingIntegrity;
      context->functions.fpCheckObstructionIntegrity = _DrawPlanar_CheckObstructionIntegrity;
 
-     context->functions.fpInitGraph = _DrawPlanar_InitGraph;
-     context->functions.fpReinitializeGraph = _DrawPlanar_ReinitializeGraph;
-     context->functions.fpEnsureArcCapacity = _DrawPlanar_EnsureArcCapacity;
      context->functions.fpSortVertices = _DrawPlanar_SortVertices;
 
      context->functions.fpReadPostprocess = _DrawPlanar_ReadPostprocess;
@@ -123,29 +119,33 @@ int  gp_AttachDrawPlanar(graphP theGraph)
      // Store the Draw context, including the data structure and the
      // function pointers, as an extension of the graph
      if (gp_AddExtension(theGraph, &DRAWPLANAR_ID, (void *) context,
-                         _DrawPlanar_DupContext, _DrawPlanar_FreeContext,
+                         _DrawPlanar_DupContext, _DrawPlanar_FreeContext, _DrawPlanar_GetMemoryUsage,
                          &context->functions) != OK)
      {
          _DrawPlanar_FreeContext(context);
          return NOTOK;
      }
 
-     // Create the Draw-specific structures if the size of the graph is known
-     // Attach functions are typically invoked after gp_New(), but if a graph
-     // extension must be attached before gp_Read(), then the attachment
-     // also happens before gp_InitGraph() because gp_Read() invokes init only
-     // after it reads the order N of the graph.  Hence, this attach call would
-     // occur when N==0 in the case of gp_Read().
-     // But if a feature is attached after gp_InitGraph(), then N > 0 and so we
-     // need to create and initialize all the custom data structures
-     if (theGraph->N > 0)
+     // The Draw-specific structures are the parallel arrays for edges and
+     // vertices, which are columns managed by the core.  Attach functions are
+     // typically invoked after gp_New(), but if a graph extension must be
+     // attached before gp_Read(), then the attachment also happens before
+     // gp_InitGraph() because gp_Read() invokes init only after it reads the
+     // order N of the graph.  The core creates the columns when gp_InitGraph()
+     // is invoked or, if N > 0 already, right away.
+     // The columns hold the drawing, so gp_Trim() keeps them, and their
+     // records are all zero, which can be set with memset if NIL is 0.
+     if (gp_AddExtensionColumn(theGraph, DRAWPLANAR_ID,
+                               COLUMNFLAGS_EDGE | COLUMNFLAGS_KEEPONTRIM | (NIL == 0 ? COLUMNFLAGS_NILINIT : 0),
+                               sizeof(DrawPlanar_EdgeRec), offsetof(DrawPlanarContext, E),
+                               _DrawPlanar_InitEdgeColumnRec) != OK ||
+         gp_AddExtensionColumn(theGraph, DRAWPLANAR_ID,
+                               COLUMNFLAGS_VERTEX | COLUMNFLAGS_KEEPONTRIM | (NIL == 0 ? COLUMNFLAGS_NILINIT : 0),
+                               sizeof(DrawPlanar_VertexInfo), offsetof(DrawPlanarContext, VI),
+                               _DrawPlanar_InitVertexColumnRec) != OK)
      {
-         if (_DrawPlanar_CreateStructures(context) != OK ||
-             _DrawPlanar_InitStructures(context) != OK)
-         {
-             _DrawPlanar_FreeContext(context);
-             return NOTOK;
-         }
+         gp_DetachDrawPlanar(theGraph);
+         return NOTOK;
      }
 
      return OK;
@@ -169,78 +169,12 @@ void _DrawPlanar_ClearStructures(DrawPlanarContext *context)
     if (!context->initialized)
     {
         // Before initialization, the pointers are stray, not NULL
-        // Once NULL or allocated, free() or LCFree() can do the job
+        // The E and VI columns are only set here; the core manages them
         context->E = NULL;
         context->VI = NULL;
 
         context->initialized = 1;
     }
-    else
-    {
-        if (context->E != NULL)
-        {
-            free(context->E);
-            context->E = NULL;
-        }
-        if (context->VI != NULL)
-        {
-            free(context->VI);
-            context->VI = NULL;
-        }
-    }
-}
-
-/********************************************************************
- _DrawPlanar_CreateStructures()
- Create uninitialized structures for the vertex and edge levels,
- and initialized structures for the graph level
- ********************************************************************/
-int  _DrawPlanar_CreateStructures(DrawPlanarContext *context)
-{
-	 graphP theGraph = context->theGraph;
-     int VIsize = gp_PrimaryVertexIndexBound(theGraph);
-     int Esize = gp_EdgeIndexBound(theGraph);
-
-     if (theGraph->N <= 0)
-         return NOTOK;
-
-     if ((context->E = (DrawPlanar_EdgeRecP) malloc(Esize*sizeof(DrawPlanar_EdgeRec))) == NULL ||
-         (context->VI = (DrawPlanar_VertexInfoP) malloc(VIsize*sizeof(DrawPlanar_VertexInfo))) == NULL
-        )
-     {
-         return NOTOK;
-     }
-
-     return OK;
-}
-
-/********************************************************************
- _DrawPlanar_InitStructures()
- Intended to be called when N>0.
- Initializes vertex and edge levels only. Graph level is
- already initialized in _CreateStructures()
- ********************************************************************/
-int  _DrawPlanar_InitStructures(DrawPlanarContext *context)
-{
-#if NIL == 0
-	memset(context->VI, NIL_CHAR, gp_PrimaryVertexIndexBound(context->theGraph) * sizeof(DrawPlanar_VertexInfo));
-	memset(context->E, NIL_CHAR, gp_EdgeIndexBound(context->theGraph) * sizeof(DrawPlanar_EdgeRec));
-#else
-     int v, e, Esize;
-     graphP theGraph = context->theGraph;
-
-     if (theGraph->N <= 0)
-         return NOTOK;
-
-     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
-          _DrawPlanar_InitVertexInfo(context, v);
-
-     Esize = gp_EdgeIndexBound(theGraph);
-     for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
-          _DrawPlanar_InitEdgeRec(context, e);
-#endif
-
-     return OK;
 }
 
 /********************************************************************
@@ -250,103 +184,43 @@ int  _DrawPlanar_InitStructures(DrawPlanarContext *context)
 void *_DrawPlanar_DupContext(void *pContext, void *theGraph)
 {
      DrawPlanarContext *context = (DrawPlanarContext *) pContext;
-     DrawPlanarContext *newContext = (DrawPlanarContext *) malloc(sizeof(DrawPlanarContext));
+     DrawPlanarContext *newContext = (DrawPlanarContext *) gp_AllocMemory((graphP) theGraph, sizeof(DrawPlanarContext));
 
      if (newContext != NULL)
      {
-         int VIsize = gp_PrimaryVertexIndexBound((graphP) theGraph);
-         int Esize = gp_EdgeIndexBound((graphP) theGraph);
-
          *newContext = *context;
 
          newContext->theGraph = (graphP) theGraph;
 
+         // The E and VI columns are copied by gp_CopyExtensions()
          newContext->initialized = 0;
          _DrawPlanar_ClearStructures(newContext);
-         if (((graphP) theGraph)->N > 0)
-         {
-             if (_DrawPlanar_CreateStructures(newContext) != OK)
-             {
-                 _DrawPlanar_FreeContext(newContext);
-                 return NULL;
-             }
-
-             // Initialize custom data structures by copying
-             memcpy(newContext->E, context->E, Esize*sizeof(DrawPlanar_EdgeRec));
-             memcpy(newContext->VI, context->VI, VIsize*sizeof(DrawPlanar_VertexInfo));
-         }
      }
 
      return newContext;
 }
 
 /********************************************************************
- _DrawPlanar_FreeContext()
+ _DrawPlanar_GetMemoryUsage()
+ Returns the bytes allocated for the context and its structures.
  ********************************************************************/
 
-void _DrawPlanar_FreeContext(void *pContext)
+size_t _DrawPlanar_GetMemoryUsage(void *pContext)
 {
-     DrawPlanarContext *context = (DrawPlanarContext *) pContext;
-
-     _DrawPlanar_ClearStructures(context);
-     free(pContext);
-}
-
-/********************************************************************
- ********************************************************************/
-
-int  _DrawPlanar_InitGraph(graphP theGraph, int N)
-{
-    DrawPlanarContext *context = NULL;
-    gp_FindExtension(theGraph, DRAWPLANAR_ID, (void *)&context);
-
-    if (context == NULL)
-        return NOTOK;
-
-	theGraph->N = N;
-	theGraph->NV = N;
-	if (theGraph->arcCapacity == 0)
-		theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
-
-	if (_DrawPlanar_CreateStructures(context) != OK ||
-		_DrawPlanar_InitStructures(context) != OK)
-		return NOTOK;
-
-	context->functions.fpInitGraph(theGraph, N);
-
-    return OK;
+     // The E and VI columns are counted by gp_GetMemoryUsage()
+     return sizeof(DrawPlanarContext);
 }
 
 /********************************************************************
+ _DrawPlanar_FreeContext()
  ********************************************************************/
 
-void _DrawPlanar_ReinitializeGraph(graphP theGraph)
+void _DrawPlanar_FreeContext(void *pContext)
 {
-    DrawPlanarContext *context = NULL;
-    gp_FindExtension(theGraph, DRAWPLANAR_ID, (void *)&context);
-
-    if (context != NULL)
-    {
-		// Reinitialize the graph
-		context->functions.fpReinitializeGraph(theGraph);
-
-		// Do the reinitialization that is specific to this module
-		_DrawPlanar_InitStructures(context);
-    }
-}
-
-/********************************************************************
- The current implementation does not support an increase of arc
- (edge record) capacity once the extension is attached to the graph
- data structure.  This is only due to not being necessary to support.
- For now, it is easy to ensure the correct capacity before attaching
- the extension, but support could be added later if there is some
- reason to do so.
- ********************************************************************/
+     DrawPlanarContext *context = (DrawPlanarContext *) pContext;
 
-int  _DrawPlanar_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
-{
-	return NOTOK;
+     _DrawPlanar_ClearStructures(context);
+     gp_FreeMemory(context->theGraph, pContext);
 }
 
 /********************************************************************
@@ -380,7 +254,7 @@ int  _DrawPlanar_SortVertices(graphP theGraph)
             // to the index values of the vertices.  This could be done very easily with an extra array in
             // which, for each v, newVI[index of v] = VI[v].  However, this loop avoids memory allocation
             // by performing the operation (almost) in-place, except for the pre-existing visitation flags.
-            _ClearVertexVisitedFlags(theGraph, FALSE);
+            _ClearVertexVisitedFlags(theGraph);
             for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
             {
             	// If the correct data has already been placed into position v
@@ -477,6 +351,16 @@ void _DrawPlanar_InitEdgeRec(DrawPlanarContext *context, int e)
     context->E[e].end = 0;
 }
 
+/********************************************************************
+ _DrawPlanar_InitEdgeColumnRec()
+ The initRecord of the edge column, given to gp_AddExtensionColumn()
+ ********************************************************************/
+
+void _DrawPlanar_InitEdgeColumnRec(void *pContext, int e)
+{
+    _DrawPlanar_InitEdgeRec((DrawPlanarContext *) pContext, e);
+}
+
 /********************************************************************
  ********************************************************************/
 
@@ -493,6 +377,16 @@ void _DrawPlanar_InitVertexInfo(DrawPlanarContext *context, int v)
     context->VI[v].tie[1] = NIL;
 }
 
+/********************************************************************
+ _DrawPlanar_InitVertexColumnRec()
+ The initRecord of the vertex column, given to gp_AddExtensionColumn()
+ ********************************************************************/
+
+void _DrawPlanar_InitVertexColumnRec(void *pContext, int v)
+{
+    _DrawPlanar_InitVertexInfo((DrawPlanarContext *) pContext, v);
+}
+
 /********************************************************************
  ********************************************************************/
 
@@ -621,7 +515,7 @@ int  _DrawPlanar_WritePostprocess(graphP theGraph, void **pExtraData, long *pExt
             int v, e, EsizeOccupied;
             char line[64];
             int maxLineSize = 64, extraDataPos = 0;
-            char *extraData = (char *) malloc((1 + theGraph->N + 2*theGraph->M + 1) * maxLineSize * sizeof(char));
+            char *extraData = (char *) gp_ReallocMemory(theGraph, NULL, (1 + theGraph->N + 2*theGraph->M + 1) * maxLineSize * sizeof(char));
             int zeroBasedVertexOffset = (theGraph->internalFlags & FLAGS_ZEROBASEDIO) ? gp_GetFirstVertex(theGraph) : 0;
             int zeroBasedEdgeOffset = (theGraph->internalFlags & FLAGS_ZEROBASEDIO) ? gp_GetFirstEdge(theGraph) : 0;
 
@@ -632,7 +526,7 @@ int  _DrawPlanar_WritePostprocess(graphP theGraph, void **pExtraData, long *pExt
             // and line array size are needed to handle very large graphs
             if (theGraph->N > 2000000000)
             {
-                free(extraData);
+                gp_FreeMemory(theGraph, extraData);
                 return NOTOK;
             }
 
@@ -5,21 +5,28 @@ See the LICENSE.TXT file for licensing information.
 */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "graph.h"
+#include "platformTime.h"
 
 /* Imported functions */
 
-extern void _ClearVertexVisitedFlags(graphP theGraph, int);
+extern void _ClearVertexVisitedFlags(graphP theGraph);
 
 extern int _IsolateKuratowskiSubgraph(graphP theGraph, int v, int R);
 extern int _IsolateOuterplanarObstruction(graphP theGraph, int v, int R);
 
 extern void _InitVertexRec(graphP theGraph, int v);
+extern void _SetEdgeColumns(graphP theGraph, edgeRecP E, int Esize);
 
 /* Private functions (some are exported to system only) */
 
 int  _EmbeddingInitialize(graphP theGraph);
+int  _CompactArcs(graphP theGraph);
+int  _RestoreArcOrder(graphP theGraph);
+int  _PermuteEdgePairs(graphP theGraph, int *toPair, int *fromPair);
+int  _RebuildEdgeHoles(graphP theGraph);
 
 void _EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, int RootVertex, int W, int WPrevLink);
 
@@ -31,6 +38,7 @@ void _WalkUp(graphP theGraph, int v, int e);
 int  _WalkDown(graphP theGraph, int v, int RootVertex);
 
 int  _HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R);
+int  _InvokeHandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R);
 void _AdvanceFwdArcList(graphP theGraph, int v, int child, int nextChild);
 
 int  _EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult);
@@ -80,11 +88,18 @@ int gp_Embed(graphP theGraph, int embedFlags)
 {
 int v, e, c;
 int RetVal = OK;
+unsigned long long startTime, loopStartTime, loopEndTime, endTime;
+unsigned long long priorIsolationTime, priorPostprocessTime, restoreStartTime;
 
     // Basic parameter checks
-    if (theGraph==NULL)
+    if (theGraph==NULL || gp_IsTrimmed(theGraph))
     	return NOTOK;
 
+    gp_NotifyEmbedPhase(theGraph, EMBEDPHASE_NONE);
+    startTime = platform_GetTimeNs();
+    theGraph->stats.numEmbeds++;
+    gp_TraceEvent(theGraph, TRACEEVENT_EMBEDSTART, theGraph->N, embedFlags, 0, 0);
+
     // Preprocessing
     theGraph->embedFlags = embedFlags;
 
@@ -92,10 +107,16 @@ int RetVal = OK;
     if (theGraph->functions.fpEmbeddingInitialize(theGraph) != OK)
     	return NOTOK;
 
+    loopStartTime = platform_GetTimeNs();
+    theGraph->stats.initializeTime += loopStartTime - startTime;
+    gp_NotifyEmbedPhase(theGraph, EMBEDPHASE_INITIALIZE);
+    priorIsolationTime = theGraph->stats.isolationTime;
+
     // In reverse DFI order, embed the back edges from each vertex to its DFS descendants.
     for (v = gp_GetLastVertex(theGraph); gp_VertexInRangeDescending(theGraph, v); v--)
     {
           RetVal = OK;
+          gp_TraceEvent(theGraph, TRACEEVENT_VERTEXSTEP, v, 0, 0, 0);
 
           // Walkup calls establish Pertinence in Step v
           // Do the Walkup for each cycle edge from v to a DFS descendant W.
@@ -132,10 +153,109 @@ int RetVal = OK;
         	  break;
     }
 
+    // The edge addition time excludes any obstruction isolation done by the Walkdown
+    gp_NotifyEmbedPhase(theGraph, EMBEDPHASE_EDGEADDITION);
+    loopEndTime = platform_GetTimeNs();
+    theGraph->stats.edgeAdditionTime += (loopEndTime - loopStartTime) -
+    		                            (theGraph->stats.isolationTime - priorIsolationTime);
+    priorIsolationTime = theGraph->stats.isolationTime;
+    priorPostprocessTime = theGraph->stats.postprocessTime;
+
     // Postprocessing to orient the embedding and merge any remaining separated bicomps.
     // Some extension algorithms may overload this function, e.g. to do nothing if they
     // have no need of an embedding.
-    return theGraph->functions.fpEmbedPostprocess(theGraph, v, RetVal);
+    RetVal = theGraph->functions.fpEmbedPostprocess(theGraph, v, RetVal);
+
+    // If _EmbeddingInitialize() compacted the arcs, return them to their
+    // original locations, so the result is reported in the original edge IDs
+    if (theGraph->arcMap != NULL)
+    {
+    	restoreStartTime = platform_GetTimeNs();
+    	if (_RestoreArcOrder(theGraph) != OK)
+    		RetVal = NOTOK;
+    	theGraph->stats.postprocessTime += platform_GetTimeNs() - restoreStartTime;
+    }
+
+    // Whatever the core postprocessing did not account for was done by extensions
+    endTime = platform_GetTimeNs();
+    theGraph->stats.extensionPostprocessTime += (endTime - loopEndTime) -
+    		(theGraph->stats.postprocessTime - priorPostprocessTime) -
+    		(theGraph->stats.isolationTime - priorIsolationTime);
+    theGraph->stats.totalTime += endTime - startTime;
+    gp_NotifyEmbedPhase(theGraph, EMBEDPHASE_EXTENSIONPOSTPROCESS);
+    gp_TraceEvent(theGraph, TRACEEVENT_EMBEDEND, RetVal, 0, 0, 0);
+
+    return RetVal;
+}
+
+/********************************************************************
+ gp_GetEmbedStats()
+ Copies the phase timings accumulated by all gp_Embed() calls on
+ theGraph since it was created or since gp_ClearEmbedStats() into
+ the structure given by pStats.
+
+ Returns OK, or NOTOK if either parameter is NULL
+ ********************************************************************/
+
+int  gp_GetEmbedStats(graphP theGraph, embedStatsP pStats)
+{
+	if (theGraph == NULL || pStats == NULL)
+		return NOTOK;
+
+	*pStats = theGraph->stats;
+	return OK;
+}
+
+/********************************************************************
+ gp_ClearEmbedStats()
+ Resets the accumulated embedding statistics of theGraph.
+ ********************************************************************/
+
+void gp_ClearEmbedStats(graphP theGraph)
+{
+	if (theGraph != NULL)
+		memset(&theGraph->stats, 0, sizeof(embedStats));
+}
+
+/********************************************************************
+ gp_SetEmbedPhaseObserver()
+ Sets the function that gp_Embed() calls at each of its phase
+ boundaries (see embedPhaseObserver in graphStructures.h), or clears
+ it if fpObserver is NULL.  The observer is kept until it is changed
+ or the graph is cleared by gp_Free() or a failed gp_InitGraph().
+ ********************************************************************/
+
+void gp_SetEmbedPhaseObserver(graphP theGraph, embedPhaseObserver fpObserver, void *context)
+{
+	if (theGraph != NULL)
+	{
+		theGraph->fpPhaseObserver = fpObserver;
+		theGraph->phaseObserverContext = fpObserver != NULL ? context : NULL;
+	}
+}
+
+/********************************************************************
+ gp_SetEmbedOptions()
+ gp_GetEmbedOptions()
+ Sets or gets the EMBEDOPTIONS (see graph.h) that select optional
+ passes of gp_Embed().  The options persist through reinitialization
+ and are inherited by gp_DupGraph().
+
+ gp_SetEmbedOptions() returns OK, or NOTOK if theGraph is NULL
+ ********************************************************************/
+
+int  gp_SetEmbedOptions(graphP theGraph, int embedOptions)
+{
+	if (theGraph == NULL)
+		return NOTOK;
+
+	theGraph->embedOptions = embedOptions;
+	return OK;
+}
+
+int  gp_GetEmbedOptions(graphP theGraph)
+{
+	return theGraph == NULL ? 0 : theGraph->embedOptions;
 }
 
 /********************************************************************
@@ -162,11 +282,6 @@ int  _EmbeddingInitialize(graphP theGraph)
 	int DFI, v, R, uparent, u, uneighbor, e, f, eTwin, ePrev, eNext;
 	int leastValue, child;
 
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
-
 	gp_LogLine("graphEmbed.c/_EmbeddingInitialize() start\n");
 
 	theStack  = theGraph->theStack;
@@ -177,12 +292,12 @@ platform_GetTime(start);
 	// so we make sure it's still there and cleared, then we clear all vertex
 	// visited flags in prep for the Depth first search operation. */
 
-	if (sp_GetCapacity(theStack) < 2*gp_GetArcCapacity(theGraph))
+	if (sp_GetCapacity(theStack) < 2 * (stackIndex) gp_GetArcCapacity(theGraph))
 		return NOTOK;
 
 	sp_ClearStack(theStack);
 
-	_ClearVertexVisitedFlags(theGraph, FALSE);
+	_ClearVertexVisitedFlags(theGraph);
 
 	// This outer loop processes each connected component of a disconnected graph
 	// No need to compare v < N since DFI will reach N when inner loop processes the
@@ -354,12 +469,238 @@ platform_GetTime(start);
         }
     }
 
+    // (9) Optionally, relocate the arcs so those processed together are
+    //     stored together
+    if ((theGraph->embedOptions & EMBEDOPTIONS_COMPACTARCS) && theGraph->extensions == NULL)
+    {
+    	if (_CompactArcs(theGraph) != OK)
+    		return NOTOK;
+    }
+
 	gp_LogLine("graphEmbed.c/_EmbeddingInitialize() end\n");
 
-#ifdef PROFILE
-platform_GetTime(end);
-printf("Initialize embedding in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
+	return OK;
+}
+
+/********************************************************************
+ Arc compaction
+
+ The edges of a graph are stored in E in the order in which they were
+ added, so once the vertices are sorted by DFI, the arcs of a vertex
+ and those of its DFS neighbors are scattered through E.  When the
+ EMBEDOPTIONS_COMPACTARCS option is set, _EmbeddingInitialize() calls
+ _CompactArcs() to move the edge record pairs so that, in DFI order of
+ the vertices, the tree edge of each vertex is followed by the edges
+ of its sortedFwdArcList, in the order of the descendant DFIs.  Each
+ pair of twin arcs is moved together, so e and gp_GetTwinArc(e) remain
+ twins, and the Walkup and Walkdown of each step then visit the arcs of
+ the step in nearly sequential memory.
+
+ The pair moved to each location is recorded in arcMap, and gp_Embed()
+ calls _RestoreArcOrder() after postprocessing to move every pair back
+ to its original location, so the embedding or obstruction is reported
+ in the original edge IDs.  The deleted edges are then recorded as
+ holes anew, so the order in which later edge additions reuse them may
+ differ from that of an embedding without the option.
+
+ Extensions may keep per-edge data indexed by edge ID, so the arcs are
+ only compacted for graphs without extensions.
+ ********************************************************************/
+
+// The arc of the edge record pair at toPair[] that corresponds to the arc e
+#define _MapArc(theGraph, toPair, e) \
+	(gp_GetFirstEdge(theGraph) + \
+	 (toPair[((e) - gp_GetFirstEdge(theGraph)) >> 1] << 1) + \
+	 (((e) - gp_GetFirstEdge(theGraph)) & 1))
+
+#define _PairOf(theGraph, e) (((e) - gp_GetFirstEdge(theGraph)) >> 1)
+
+/********************************************************************
+ _CompactArcs()
+ Computes the compacted location of each edge record pair in use and
+ moves the pairs there.  If the memory for arcMap is not available,
+ the arcs are left where they are.
+
+ Returns OK, or NOTOK on internal failure
+ ********************************************************************/
+
+int  _CompactArcs(graphP theGraph)
+{
+	int numPairs = (gp_EdgeInUseIndexBound(theGraph) - gp_GetFirstEdge(theGraph)) >> 1;
+	int *toPair, *fromPair, numPlaced = 0, p, v, e, f;
+
+	if (numPairs == 0 ||
+		(theGraph->arcMap = (int *) gp_ReallocMemory(theGraph, NULL, 2 * (size_t) numPairs * sizeof(int))) == NULL)
+		return OK;
+
+	theGraph->numMappedPairs = numPairs;
+	toPair = theGraph->arcMap;
+	fromPair = theGraph->arcMap + numPairs;
+
+	for (p = 0; p < numPairs; p++)
+		toPair[p] = -1;
+
+	// Place the tree edge and then the forward arcs of each vertex, in DFI order
+	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+	{
+		e = gp_GetFirstArc(theGraph, v);
+		if (gp_IsArc(e) && toPair[_PairOf(theGraph, e)] < 0)
+			toPair[_PairOf(theGraph, e)] = numPlaced++;
+
+		e = f = gp_GetVertexFwdArcList(theGraph, v);
+		while (gp_IsArc(e))
+		{
+			if (toPair[_PairOf(theGraph, e)] < 0)
+				toPair[_PairOf(theGraph, e)] = numPlaced++;
+
+			e = gp_GetNextArc(theGraph, e);
+			if (e == f)
+				e = NIL;
+		}
+	}
+
+	// Any other pairs in use follow in their original order, then the holes
+	for (p = 0; p < numPairs; p++)
+		if (toPair[p] < 0 && gp_IsVertex(gp_GetNeighbor(theGraph, gp_GetFirstEdge(theGraph) + 2*p)))
+			toPair[p] = numPlaced++;
+
+	for (p = 0; p < numPairs; p++)
+		if (toPair[p] < 0)
+			toPair[p] = numPlaced++;
+
+	for (p = 0; p < numPairs; p++)
+		fromPair[toPair[p]] = p;
+
+	return _PermuteEdgePairs(theGraph, toPair, fromPair);
+}
+
+/********************************************************************
+ _RestoreArcOrder()
+ Moves each edge record pair relocated by _CompactArcs() back to its
+ original location and frees the arcMap.
+
+ Returns OK, or NOTOK if the arcs were not compacted
+ ********************************************************************/
+
+int  _RestoreArcOrder(graphP theGraph)
+{
+	int numPairs = theGraph->numMappedPairs, RetVal;
+
+	if (theGraph->arcMap == NULL)
+		return NOTOK;
+
+	RetVal = _PermuteEdgePairs(theGraph, theGraph->arcMap + numPairs, theGraph->arcMap);
+
+	gp_FreeMemory(theGraph, theGraph->arcMap);
+	theGraph->arcMap = NULL;
+	theGraph->numMappedPairs = 0;
+
+	return RetVal;
+}
+
+/********************************************************************
+ _PermuteEdgePairs()
+ Moves the edge record pair at each location p of the first
+ numMappedPairs pairs to location toPair[p], where fromPair is the
+ inverse of toPair, then updates the arcs stored in the edge records,
+ in the vertices and in the vertexInfo records to match, and records
+ the holes left by deleted edges.
+
+ The permutation is applied in place, one cycle at a time; the entries
+ of toPair are complemented to mark the locations already filled, and
+ are restored once all cycles are done.
+
+ Returns OK, or NOTOK on internal failure
+ ********************************************************************/
+
+int  _PermuteEdgePairs(graphP theGraph, int *toPair, int *fromPair)
+{
+	int numPairs = theGraph->numMappedPairs, first = gp_GetFirstEdge(theGraph);
+	int p, pos, src, e, v;
+	edgeRec tempE[2];
+	baseGraphStructure tempGraphStructure;
+	graphP tempGraph = &tempGraphStructure;
+
+	_SetEdgeColumns(tempGraph, tempE, 2);
+
+	for (p = 0; p < numPairs; p++)
+	{
+		if (toPair[p] < 0 || toPair[p] == p)
+			continue;
+
+		// Save the pair at p, then fill each location of its cycle from
+		// the location whose pair belongs there, ending with the saved pair
+		gp_CopyEdgeRec(tempGraph, 0, theGraph, first + 2*p);
+		gp_CopyEdgeRec(tempGraph, 1, theGraph, first + 2*p + 1);
+
+		pos = p;
+		while ((src = fromPair[pos]) != p)
+		{
+			gp_CopyEdgeRec(theGraph, first + 2*pos, theGraph, first + 2*src);
+			gp_CopyEdgeRec(theGraph, first + 2*pos + 1, theGraph, first + 2*src + 1);
+			toPair[src] = ~toPair[src];
+			pos = src;
+		}
+
+		gp_CopyEdgeRec(theGraph, first + 2*pos, tempGraph, 0);
+		gp_CopyEdgeRec(theGraph, first + 2*pos + 1, tempGraph, 1);
+		toPair[p] = ~toPair[p];
+	}
+
+	for (p = 0; p < numPairs; p++)
+		if (toPair[p] < 0)
+			toPair[p] = ~toPair[p];
+
+	// Map the arcs stored in the edge records
+	for (e = first; e < first + 2*numPairs; e++)
+	{
+		if (gp_IsArc(gp_GetNextArc(theGraph, e)))
+			gp_SetNextArc(theGraph, e, _MapArc(theGraph, toPair, gp_GetNextArc(theGraph, e)));
+		if (gp_IsArc(gp_GetPrevArc(theGraph, e)))
+			gp_SetPrevArc(theGraph, e, _MapArc(theGraph, toPair, gp_GetPrevArc(theGraph, e)));
+	}
+
+	// Map the arcs stored in the vertices and virtual vertices
+	for (v = gp_GetFirstVertex(theGraph); v < gp_VertexIndexBound(theGraph); v++)
+	{
+		if (gp_IsArc(gp_GetFirstArc(theGraph, v)))
+			gp_SetFirstArc(theGraph, v, _MapArc(theGraph, toPair, gp_GetFirstArc(theGraph, v)));
+		if (gp_IsArc(gp_GetLastArc(theGraph, v)))
+			gp_SetLastArc(theGraph, v, _MapArc(theGraph, toPair, gp_GetLastArc(theGraph, v)));
+	}
+
+	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+	{
+		if (gp_IsArc(gp_GetVertexFwdArcList(theGraph, v)))
+			gp_SetVertexFwdArcList(theGraph, v, _MapArc(theGraph, toPair, gp_GetVertexFwdArcList(theGraph, v)));
+		if (gp_IsArc(gp_GetVertexPertinentEdge(theGraph, v)))
+			gp_SetVertexPertinentEdge(theGraph, v, _MapArc(theGraph, toPair, gp_GetVertexPertinentEdge(theGraph, v)));
+	}
+
+	return _RebuildEdgeHoles(theGraph);
+}
+
+/********************************************************************
+ _RebuildEdgeHoles()
+ Records as holes the edge record pairs of deleted edges that are
+ below the last pair in use among the first numMappedPairs pairs.
+
+ Returns OK, or NOTOK on internal failure
+ ********************************************************************/
+
+int  _RebuildEdgeHoles(graphP theGraph)
+{
+	int first = gp_GetFirstEdge(theGraph), lastPair, p;
+
+	sp_ClearStack(theGraph->edgeHoles);
+
+	for (lastPair = theGraph->numMappedPairs - 1; lastPair >= 0; lastPair--)
+		if (gp_IsVertex(gp_GetNeighbor(theGraph, first + 2*lastPair)))
+			break;
+
+	for (p = lastPair - 1; p >= 0; p--)
+		if (gp_IsNotVertex(gp_GetNeighbor(theGraph, first + 2*p)))
+			sp_Push(theGraph->edgeHoles, first + 2*p);
 
 	return OK;
 }
@@ -387,8 +728,7 @@ int fwdArc, backArc, parentCopy;
 
     parentCopy = gp_GetPrimaryVertexFromRoot(theGraph, RootVertex);
 
-    gp_LogLine(gp_MakeLogStr5("graphEmbed.c/_EmbedBackEdgeToDescendant() V=%d, R=%d, R_out=%d, W=%d, W_in=%d",
-    		parentCopy, RootVertex, RootSide, W, WPrevLink));
+    gp_TraceEvent(theGraph, TRACEEVENT_EMBEDBACKEDGE, parentCopy, RootVertex, RootSide, W);
 
     if (gp_GetVertexFwdArcList(theGraph, parentCopy) == fwdArc)
     {
@@ -434,7 +774,8 @@ void _InvertVertex(graphP theGraph, int W)
 {
 int e, temp;
 
-	 gp_LogLine(gp_MakeLogStr1("graphEmbed.c/_InvertVertex() W=%d", W));
+	 gp_TraceEvent(theGraph, TRACEEVENT_INVERTVERTEX, W, 0, 0, 0);
+	 gp_IncrementCounter(theGraph, invertVertexFlips);
 
      // Swap the links in all the arcs of the adjacency list
      e = gp_GetFirstArc(theGraph, W);
@@ -487,8 +828,7 @@ void _MergeVertex(graphP theGraph, int W, int WPrevLink, int R)
 {
 int  e, eTwin, e_w, e_r, e_ext;
 
-	 gp_LogLine(gp_MakeLogStr4("graphEmbed.c/_MergeVertex() W=%d, W_in=%d, R=%d, R_out=%d",
-			 W, WPrevLink, R, 1^WPrevLink));
+	 gp_TraceEvent(theGraph, TRACEEVENT_MERGEVERTEX, W, WPrevLink, R, 1^WPrevLink);
 
      // All arcs leading into R from its neighbors must be changed
      // to say that they are leading into W
@@ -682,6 +1022,8 @@ int  nextZig, nextZag, R;
      // (or until the visited info optimization breaks the loop)
      while (Zig != v)
      {
+    	 gp_IncrementCounter(theGraph, walkUpHops);
+
     	 // Obtain the next vertex in a first direction and determine if it is a bicomp root
          if (gp_IsVirtualVertex(theGraph, (nextZig = gp_GetExtFaceVertex(theGraph, Zig, 1^ZigPrevLink))))
          {
@@ -850,6 +1192,8 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
 
          while (W != RootVertex)
          {
+        	 gp_IncrementCounter(theGraph, walkDownIterations);
+
              // Detect unembedded back edge descendant endpoint W
              if (gp_IsArc(gp_GetVertexPertinentEdge(theGraph, W)))
              {
@@ -857,6 +1201,7 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
             	// edge to W to form a new proper face in the embedding.
                 if (sp_NonEmpty(theGraph->theStack))
                 {
+                    gp_IncrementCounter(theGraph, mergeBicompsCalls);
                     if ((RetVal = theGraph->functions.fpMergeBicomps(theGraph, v, RootVertex, W, WPrevLink)) != OK)
                         return RetVal;
                 }
@@ -872,6 +1217,7 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
             	 // Push the vertex W and the direction of entry, then descend to a root copy R of W
                  sp_Push2(theGraph->theStack, W, WPrevLink);
                  R = gp_GetVertexFirstPertinentRoot(theGraph, W);
+                 gp_TraceEvent(theGraph, TRACEEVENT_WALKDOWNDESCENT, v, W, R, 0);
 
                  // Get the next active vertices X and Y on the external face paths emanating from R
                  X = gp_GetExtFaceVertex(theGraph, R, 0);
@@ -914,7 +1260,7 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
                 	 // Let the application decide whether it can unblock the bicomp.
                 	 // The core planarity/outerplanarity embedder simply isolates a
                 	 // planarity/outerplanary obstruction and returns NONEMBEDDABLE
-                     if ((RetVal = theGraph->functions.fpHandleBlockedBicomp(theGraph, v, RootVertex, R)) != OK)
+                     if ((RetVal = _InvokeHandleBlockedBicomp(theGraph, v, RootVertex, R)) != OK)
                          return RetVal;
 
                      // If an extension algorithm cleared the blockage, then we pop W and WPrevLink
@@ -957,6 +1303,7 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
                  // inactive vertices, but the extFace links above achieve the same result with less work.
                  else
                  {
+                     gp_IncrementCounter(theGraph, inactiveVertexHops);
                      if (theGraph->functions.fpHandleInactiveVertex(theGraph, RootVertex, &W, &WPrevLink) != OK)
                          return NOTOK;
                  }
@@ -977,7 +1324,7 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
 	     {
 	    	 // If an extension indicates it is OK to proceed despite the unembedded forward arcs, then
 	    	 // advance to the forward arcs for the next child, if any
-	    	 if ((RetVal = theGraph->functions.fpHandleBlockedBicomp(theGraph, v, RootVertex, RootVertex)) == OK)
+	    	 if ((RetVal = _InvokeHandleBlockedBicomp(theGraph, v, RootVertex, RootVertex)) == OK)
 	    		 _AdvanceFwdArcList(theGraph, v, RootEdgeChild, nextChild);
 
 	    	 return RetVal;
@@ -1029,6 +1376,40 @@ int  _HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R)
 	return RetVal;
 }
 
+/********************************************************************
+ _InvokeHandleBlockedBicomp()
+
+ Calls fpHandleBlockedBicomp() for the Walkdown and, if the call
+ isolated an embedding obstruction (NONEMBEDDABLE), charges its
+ duration to the isolation time of the embedding statistics.
+ If instead an extension cleared the blockage (OK), the resumption
+ of the Walkdown is counted.
+ ********************************************************************/
+
+int  _InvokeHandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R)
+{
+	unsigned long long startTime;
+	int RetVal;
+
+	gp_NotifyEmbedPhase(theGraph, EMBEDPHASE_EDGEADDITION);
+	startTime = platform_GetTimeNs();
+	RetVal = theGraph->functions.fpHandleBlockedBicomp(theGraph, v, RootVertex, R);
+
+	if (RetVal == NONEMBEDDABLE)
+	{
+		theGraph->stats.isolationTime += platform_GetTimeNs() - startTime;
+		gp_NotifyEmbedPhase(theGraph, EMBEDPHASE_ISOLATION);
+	}
+	else
+	{
+		if (RetVal == OK)
+			gp_IncrementCounter(theGraph, blockedBicompReentries);
+		gp_NotifyEmbedPhase(theGraph, EMBEDPHASE_EDGEADDITION);
+	}
+
+	return RetVal;
+}
+
 /********************************************************************
  _AdvanceFwdArcList()
 
@@ -1164,9 +1545,17 @@ int  RetVal = edgeEmbeddingResult;
 	// a consistent orientation to all vertices then eliminate virtual vertices
     if (edgeEmbeddingResult == OK)
     {
+    	unsigned long long startTime;
+
+    	gp_NotifyEmbedPhase(theGraph, EMBEDPHASE_EXTENSIONPOSTPROCESS);
+    	startTime = platform_GetTimeNs();
+
     	if (_OrientVerticesInEmbedding(theGraph) != OK ||
     		_JoinBicomps(theGraph) != OK)
     		RetVal = NOTOK;
+
+    	theGraph->stats.postprocessTime += platform_GetTimeNs() - startTime;
+    	gp_NotifyEmbedPhase(theGraph, EMBEDPHASE_POSTPROCESS);
     }
 
     // If the graph is embedded (OK) or NONEMBEDDABLE, we pass the result back
@@ -1238,7 +1627,7 @@ int  R;
 int  _OrientVerticesInBicomp(graphP theGraph, int BicompRoot, int PreserveSigns)
 {
 int  W, e, invertedFlag;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+stackIndex stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push2(theGraph->theStack, BicompRoot, 0);
 
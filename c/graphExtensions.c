@@ -12,6 +12,7 @@ See the LICENSE.TXT file for licensing information.
 #include "graphExtensions.private.h"
 #include "graphExtensions.h"
 #include "graphFunctionTable.h"
+#include "graph.h"
 
 /* Imported functions */
 
@@ -19,11 +20,23 @@ extern void _InitFunctionTable(graphP theGraph);
 
 /* Private function */
 
-void _FreeExtension(graphExtensionP extension);
+void _FreeExtension(graphP theGraph, graphExtensionP extension);
 void _OverloadFunctions(graphP theGraph, graphFunctionTableP functions);
 void _FixupFunctionTables(graphP theGraph, graphExtensionP curr);
 graphExtensionP _FindNearestOverload(graphP theGraph, graphExtensionP target, int functionIndex);
 
+int  _LayoutExtensionColumns(graphP theGraph, int columnFlags, int columnSize, int copySize);
+void _InitExtensionColumns(graphP theGraph, int columnType, int bound);
+void _InitColumn(void *context, graphColumnP column, void *base, int first, int bound);
+void _FreeExtensionColumns(graphP theGraph);
+
+#define COLUMN_ALIGNMENT    16
+#define _AlignColumn(size) (((size) + COLUMN_ALIGNMENT - 1) & ~((size_t) COLUMN_ALIGNMENT - 1))
+#define _GetColumnSize(theGraph, columnType) \
+        ((columnType) == COLUMNFLAGS_EDGE ? gp_EdgeIndexBound(theGraph) : gp_PrimaryVertexIndexBound(theGraph))
+#define _GetColumnPointer(extension, column) \
+        ((void **) ((char *) (extension)->context + (column)->contextOffset))
+
 /********************************************************************
  * The moduleIDGenerator is used to help ensure that all extensions
  * added during a run-time have a different integer identifier.
@@ -61,6 +74,14 @@ static int moduleIDGenerator = 0;
      allocated context structure.  The pointer to this function is
      passed to the "dupContext" parameter of gp_AddExtension()
 
+     Note: The graph being duplicated into already has the size and
+     edge high water mark of the source graph, so per-edge data at and
+     above gp_EdgeTouchedIndexBound() can be initialized rather than
+     copied, as it is still in its initial state in the source.
+     Note: The columns added with gp_AddExtensionColumn() are copied
+     by the core after the context is duplicated, so the function
+     need not (and should not) allocate or copy them.
+
      Note: It is useful to store in your context structure a pointer
      to the graph that the context is extending.  There are certain
      function overloads you will perform that will only receive
@@ -73,6 +94,19 @@ static int moduleIDGenerator = 0;
      "context" parameter to gp_AddExtension().
      The free function pointer should be passed as the "freeContext"
      parameter to gp_AddExtension()
+     Note: The context and any structures of the extension should be
+     allocated with gp_AllocMemory() and freed with gp_FreeMemory(),
+     given the graph, so that they use the allocator of the graph
+     (see gp_SetAllocator()).  This is another reason to keep in the
+     context the pointer to its graph.
+
+     Optionally, also define a function that returns the number of bytes
+     allocated for your context data structure, including its parallel
+     arrays and other structures.  It receives the same void pointer as
+     the free function, and its pointer is passed as the "getMemoryUsage"
+     parameter to gp_AddExtension() so that gp_GetMemoryUsage() can
+     account for the extension.  Pass NULL if the extension does not
+     report its memory usage.
 
   5) The expected method of attaching your feature to a graph is to
      create a function called gp_AttachFeature(), where 'Feature' is
@@ -155,7 +189,17 @@ static int moduleIDGenerator = 0;
 
      c) The _Feature_InitStructures() should invoke just the functions
         needed to initialize the custom VertexRec, VertexInfo and EdgeRec
-        data members, if any.
+        data members, if any.  When it is called on reinitialization,
+        only the EdgeRecs below the gp_EdgeTouchedIndexBound() that the
+        graph had before the base fpReinitializeGraph() need be initialized.
+
+     However, a parallel array with one record per edge record or per
+     primary vertex is best declared as a column with gp_AddExtensionColumn()
+     right after gp_AddExtension().  The core then allocates, initializes,
+     reinitializes, grows, copies, trims and frees the column along with
+     the arrays of the graph, so these functions only deal with the other
+     structures of the extension, and no overloads of fpEnsureArcCapacity()
+     or fpTrimGraph() are needed for the column.
 
   8) Define a function gp_DetachFeature() that invokes gp_RemoveExtension()
      This should be done for consistency, so that users of a feature
@@ -178,6 +222,8 @@ static int moduleIDGenerator = 0;
                The context is owned by the extension and freed with freeContext()
  @param dupContext - a function capable of duplicating the context data
  @param freeContext - a function capable of freeing the context data
+ @param getMemoryUsage - a function that returns the bytes allocated for
+                      the context data, or NULL if none is provided
  @param functions - pointer to a table of functions stored in the data context.
                         The table of functions is an input and output parameter.
                         On input, the table consists of new function pointers
@@ -198,6 +244,7 @@ int gp_AddExtension(graphP theGraph,
                     void *context,
                     void *(*dupContext)(void *, void *),
                     void (*freeContext)(void *),
+                    size_t (*getMemoryUsage)(void *),
                     graphFunctionTableP functions)
 {
     graphExtensionP newExtension = NULL;
@@ -222,7 +269,7 @@ int gp_AddExtension(graphP theGraph,
     }
 
     // Allocate the new extension
-    if ((newExtension = (graphExtensionP) malloc(sizeof(graphExtension))) == NULL)
+    if ((newExtension = (graphExtensionP) gp_AllocMemory(theGraph, sizeof(graphExtension))) == NULL)
     {
         return NOTOK;
     }
@@ -232,7 +279,10 @@ int gp_AddExtension(graphP theGraph,
     newExtension->context = context;
     newExtension->dupContext = dupContext;
     newExtension->freeContext = freeContext;
+    newExtension->getMemoryUsage = getMemoryUsage;
     newExtension->functions = functions;
+    newExtension->columns = NULL;
+    newExtension->numColumns = 0;
 
     _OverloadFunctions(theGraph, functions);
 
@@ -245,6 +295,86 @@ int gp_AddExtension(graphP theGraph,
 
 }
 
+/********************************************************************
+ gp_AddExtensionColumn()
+ @param theGraph - the graph having the extension
+ @param moduleID - the identifier of the extension
+ @param columnFlags - COLUMNFLAGS_EDGE for a column with a record per edge
+                   record, or COLUMNFLAGS_VERTEX for a column with a record
+                   per primary vertex, possibly combined with
+                   COLUMNFLAGS_NILINIT and COLUMNFLAGS_KEEPONTRIM
+ @param recordSize - the size of a record of the column
+ @param contextOffset - the offsetof() the column pointer in the context
+ @param initRecord - a function that initializes the record at an index,
+                  given the extension context
+
+ Declares a parallel array of the extension whose storage is managed by
+ the core.  The core keeps the columns of each kind of all extensions in
+ one block that it allocates on initialization, initializes along with
+ the graph, regrows with the arc capacity, copies in gp_CopyExtensions()
+ and frees with the extension, and it updates the column pointer in the
+ context whenever the column moves.  A column without COLUMNFLAGS_KEEPONTRIM
+ is released by gp_Trim(), which sets its pointer to NULL.
+
+ If the graph is already initialized, the column is allocated and
+ initialized before this function returns.
+
+ @return OK on success, NOTOK on invalid parameters or allocation failure
+ ********************************************************************/
+int gp_AddExtensionColumn(graphP theGraph, int moduleID, int columnFlags,
+                          size_t recordSize, size_t contextOffset,
+                          void (*initRecord)(void *, int))
+{
+    graphExtensionP extension = NULL;
+    graphColumnP newColumns = NULL;
+    int columnType = columnFlags & (COLUMNFLAGS_EDGE | COLUMNFLAGS_VERTEX);
+
+    if (theGraph == NULL || recordSize == 0 || initRecord == NULL ||
+        (columnType != COLUMNFLAGS_EDGE && columnType != COLUMNFLAGS_VERTEX))
+    {
+        return NOTOK;
+    }
+
+    for (extension = theGraph->extensions; extension != NULL;
+         extension = (graphExtensionP) extension->next)
+    {
+        if (extension->moduleID == moduleID)
+            break;
+    }
+
+    if (extension == NULL)
+        return NOTOK;
+
+    newColumns = (graphColumnP) gp_ReallocMemory(theGraph, extension->columns,
+                                                 (extension->numColumns + 1) * sizeof(graphColumn));
+    if (newColumns == NULL)
+        return NOTOK;
+
+    extension->columns = newColumns;
+    newColumns += extension->numColumns;
+    newColumns->columnFlags = columnFlags;
+    newColumns->recordSize = recordSize;
+    newColumns->contextOffset = contextOffset;
+    newColumns->initRecord = initRecord;
+    *_GetColumnPointer(extension, newColumns) = NULL;
+    extension->numColumns++;
+
+    // If the graph is already sized, the block of columns of the type is
+    // laid out again, which keeps the content of the other columns
+    if (theGraph->N > 0)
+    {
+        int columnSize = _GetColumnSize(theGraph, columnType);
+
+        if (_LayoutExtensionColumns(theGraph, columnType, columnSize, columnSize) != OK)
+        {
+            extension->numColumns--;
+            return NOTOK;
+        }
+    }
+
+    return OK;
+}
+
 /********************************************************************
  _OverloadFunctions()
  For each non-NULL function pointer, the pointer becomes the new value
@@ -386,6 +516,8 @@ int gp_RemoveExtension(graphP theGraph, int moduleID)
     // (since it is already gone)
     if (curr != NULL)
     {
+        int hadColumns = curr->numColumns > 0;
+
         _FixupFunctionTables(theGraph, curr);
 
         // Unhook the curr extension
@@ -394,7 +526,19 @@ int gp_RemoveExtension(graphP theGraph, int moduleID)
         else theGraph->extensions = next;
 
         // Free the curr extension
-        _FreeExtension(curr);
+        _FreeExtension(theGraph, curr);
+
+        // Lay out the blocks of columns without those of the curr extension.
+        // If that fails, the remaining columns just stay in the old blocks.
+        if (hadColumns && theGraph->N > 0)
+        {
+            int keepFlags = gp_IsTrimmed(theGraph) ? COLUMNFLAGS_KEEPONTRIM : 0;
+
+            _LayoutExtensionColumns(theGraph, COLUMNFLAGS_EDGE | keepFlags,
+                                    gp_EdgeIndexBound(theGraph), gp_EdgeIndexBound(theGraph));
+            _LayoutExtensionColumns(theGraph, COLUMNFLAGS_VERTEX | keepFlags,
+                                    gp_PrimaryVertexIndexBound(theGraph), gp_PrimaryVertexIndexBound(theGraph));
+        }
     }
 
     return OK;
@@ -480,7 +624,7 @@ int gp_CopyExtensions(graphP dstGraph, graphP srcGraph)
 
     while (next != NULL)
     {
-        if ((newNext = (graphExtensionP) malloc(sizeof(graphExtension))) == NULL)
+        if ((newNext = (graphExtensionP) gp_AllocMemory(dstGraph, sizeof(graphExtension))) == NULL)
         {
             gp_FreeExtensions(dstGraph);
             return NOTOK;
@@ -490,7 +634,10 @@ int gp_CopyExtensions(graphP dstGraph, graphP srcGraph)
         newNext->context = next->dupContext(next->context, dstGraph);
         newNext->dupContext = next->dupContext;
         newNext->freeContext = next->freeContext;
+        newNext->getMemoryUsage = next->getMemoryUsage;
         newNext->functions = next->functions;
+        newNext->columns = NULL;
+        newNext->numColumns = 0;
         newNext->next = NULL;
 
         if (newLast != NULL)
@@ -499,9 +646,54 @@ int gp_CopyExtensions(graphP dstGraph, graphP srcGraph)
             dstGraph->extensions = newNext;
 
         newLast = newNext;
+
+        if (newNext->context == NULL)
+        {
+            gp_FreeExtensions(dstGraph);
+            return NOTOK;
+        }
+
+        // Give the new context the column declarations and, for now, the
+        // columns of the srcGraph, which are copied into dstGraph below
+        if (next->numColumns > 0)
+        {
+            int K;
+
+            if ((newNext->columns = (graphColumnP) gp_ReallocMemory(dstGraph, NULL, next->numColumns * sizeof(graphColumn))) == NULL)
+            {
+                gp_FreeExtensions(dstGraph);
+                return NOTOK;
+            }
+
+            memcpy(newNext->columns, next->columns, next->numColumns * sizeof(graphColumn));
+            newNext->numColumns = next->numColumns;
+
+            for (K = 0; K < newNext->numColumns; K++)
+                *_GetColumnPointer(newNext, newNext->columns + K) =
+                        dstGraph->N > 0 ? *_GetColumnPointer(next, next->columns + K) : NULL;
+        }
+
         next = (graphExtensionP) next->next;
     }
 
+    // Copy the columns.  The edge records at and above the edge high water
+    // mark of dstGraph are in their initial state, so they are initialized
+    if (dstGraph->N > 0)
+    {
+        int Eprefix = gp_EdgeTouchedIndexBound(dstGraph);
+
+        if (Eprefix > gp_EdgeIndexBound(srcGraph))
+            Eprefix = gp_EdgeIndexBound(srcGraph);
+
+        if (_LayoutExtensionColumns(dstGraph, COLUMNFLAGS_EDGE, gp_EdgeIndexBound(dstGraph), Eprefix) != OK ||
+            _LayoutExtensionColumns(dstGraph, COLUMNFLAGS_VERTEX, gp_PrimaryVertexIndexBound(dstGraph),
+                                    gp_PrimaryVertexIndexBound(dstGraph)) != OK)
+        {
+            gp_FreeExtensions(dstGraph);
+            return NOTOK;
+        }
+    }
+
     return OK;
 }
 
@@ -524,23 +716,159 @@ void gp_FreeExtensions(graphP theGraph)
         while (curr != NULL)
         {
             next = (graphExtensionP) curr->next;
-            _FreeExtension(curr);
+            _FreeExtension(theGraph, curr);
             curr = next;
         }
 
         theGraph->extensions = NULL;
         _InitFunctionTable(theGraph);
+
+        _FreeExtensionColumns(theGraph);
     }
 }
 
 /********************************************************************
  _FreeExtension()
  ********************************************************************/
-void _FreeExtension(graphExtensionP extension)
+void _FreeExtension(graphP theGraph, graphExtensionP extension)
 {
     if (extension->context != NULL && extension->freeContext != NULL)
     {
         extension->freeContext(extension->context);
     }
-    free(extension);
+    if (extension->columns != NULL)
+    {
+        gp_FreeMemory(theGraph, extension->columns);
+    }
+    gp_FreeMemory(theGraph, extension);
+}
+
+/********************************************************************
+ _LayoutExtensionColumns()
+ Moves the columns of the type given in columnFlags (COLUMNFLAGS_EDGE
+ or COLUMNFLAGS_VERTEX) into a new block in which each column has
+ columnSize records, and frees the old block.  The first copySize
+ records of each column are copied from where the column pointer
+ points, if it is not NULL, and the rest are initialized.
+
+ Only the columns that have all of the columnFlags are kept; the
+ pointers of the other columns of the type are set to NULL.
+
+ Returns OK, or NOTOK on allocation failure, in which case the
+         columns are unchanged
+ ********************************************************************/
+int  _LayoutExtensionColumns(graphP theGraph, int columnFlags, int columnSize, int copySize)
+{
+    int columnType = columnFlags & (COLUMNFLAGS_EDGE | COLUMNFLAGS_VERTEX);
+    graphColumnBlock *block = columnType == COLUMNFLAGS_EDGE ? &theGraph->edgeColumns : &theGraph->vertexColumns;
+    graphExtensionP extension;
+    graphColumnP column;
+    char *newBase = NULL;
+    size_t newSize = 0, offset = 0;
+    int K, first;
+
+    if (copySize > columnSize)
+        copySize = columnSize;
+
+    // The columns are placed one after another, each aligned
+    for (extension = theGraph->extensions; extension != NULL;
+         extension = (graphExtensionP) extension->next)
+    {
+        for (K = 0, column = extension->columns; K < extension->numColumns; K++, column++)
+            if ((column->columnFlags & columnFlags) == columnFlags)
+                newSize += _AlignColumn(column->recordSize * (size_t) columnSize);
+    }
+
+    if (newSize > 0 && (newBase = (char *) gp_AllocMemory(theGraph, newSize)) == NULL)
+        return NOTOK;
+
+    for (extension = theGraph->extensions; extension != NULL;
+         extension = (graphExtensionP) extension->next)
+    {
+        for (K = 0, column = extension->columns; K < extension->numColumns; K++, column++)
+        {
+            void **pColumn = _GetColumnPointer(extension, column);
+
+            if (!(column->columnFlags & columnType))
+                continue;
+
+            if ((column->columnFlags & columnFlags) != columnFlags)
+            {
+                *pColumn = NULL;
+                continue;
+            }
+
+            first = 0;
+            if (*pColumn != NULL)
+            {
+                first = copySize;
+                memcpy(newBase + offset, *pColumn, first * column->recordSize);
+            }
+
+            *pColumn = newBase + offset;
+            _InitColumn(extension->context, column, *pColumn, first, columnSize);
+            offset += _AlignColumn(column->recordSize * (size_t) columnSize);
+        }
+    }
+
+    gp_FreeMemory(theGraph, block->base);
+    block->base = newBase;
+    block->size = newSize;
+
+    return OK;
+}
+
+/********************************************************************
+ _InitExtensionColumns()
+ Initializes the records below bound of each column of the columnType
+ ********************************************************************/
+void _InitExtensionColumns(graphP theGraph, int columnType, int bound)
+{
+    graphExtensionP extension;
+    graphColumnP column;
+    int K;
+
+    for (extension = theGraph->extensions; extension != NULL;
+         extension = (graphExtensionP) extension->next)
+    {
+        for (K = 0, column = extension->columns; K < extension->numColumns; K++, column++)
+        {
+            void *base = *_GetColumnPointer(extension, column);
+
+            if ((column->columnFlags & columnType) && base != NULL)
+                _InitColumn(extension->context, column, base, 0, bound);
+        }
+    }
+}
+
+/********************************************************************
+ _InitColumn()
+ Initializes the records of a column from first up to bound
+ ********************************************************************/
+void _InitColumn(void *context, graphColumnP column, void *base, int first, int bound)
+{
+#if NIL == 0 || NIL == -1
+    if (column->columnFlags & COLUMNFLAGS_NILINIT)
+    {
+        if (bound > first)
+            memset((char *) base + first * column->recordSize, NIL_CHAR,
+                   (bound - first) * column->recordSize);
+        return;
+    }
+#endif
+
+    for (; first < bound; first++)
+        column->initRecord(context, first);
+}
+
+/********************************************************************
+ _FreeExtensionColumns()
+ Frees the blocks of columns, whose extensions have been freed
+ ********************************************************************/
+void _FreeExtensionColumns(graphP theGraph)
+{
+    gp_FreeMemory(theGraph, theGraph->edgeColumns.base);
+    gp_FreeMemory(theGraph, theGraph->vertexColumns.base);
+    theGraph->edgeColumns.base = theGraph->vertexColumns.base = NULL;
+    theGraph->edgeColumns.size = theGraph->vertexColumns.size = 0;
 }
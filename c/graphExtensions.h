@@ -18,8 +18,24 @@ int gp_AddExtension(graphP theGraph,
                     void *context,
                     void *(*dupContext)(void *, void *),
                     void (*freeContext)(void *),
+                    size_t (*getMemoryUsage)(void *),
                     graphFunctionTableP overloadTable);
 
+/* Flags for gp_AddExtensionColumn().  Exactly one of COLUMNFLAGS_EDGE and
+   COLUMNFLAGS_VERTEX must be given.  COLUMNFLAGS_NILINIT indicates that
+   initRecord sets every member to NIL, so a column can be cleared with
+   memset where NIL allows it.  COLUMNFLAGS_KEEPONTRIM indicates that the
+   column holds a result that gp_Trim() must keep. */
+
+#define COLUMNFLAGS_EDGE        1
+#define COLUMNFLAGS_VERTEX      2
+#define COLUMNFLAGS_NILINIT     4
+#define COLUMNFLAGS_KEEPONTRIM  8
+
+int gp_AddExtensionColumn(graphP theGraph, int moduleID, int columnFlags,
+                          size_t recordSize, size_t contextOffset,
+                          void (*initRecord)(void *, int));
+
 int gp_FindExtension(graphP theGraph, int moduleID, void **pContext);
 void *gp_GetExtension(graphP theGraph, int moduleID);
 
@@ -13,18 +13,57 @@ See the LICENSE.TXT file for licensing information.
 extern "C" {
 #endif
 
+/********************************************************************
+ graphColumn
+ A per-edge or per-vertex array of an extension that the core allocates,
+ grows, copies and initializes along with the arrays of the graph (see
+ gp_AddExtensionColumn())
+        columnFlags: the COLUMNFLAGS of the column (see graphExtensions.h)
+        recordSize: the size of each record of the column
+        contextOffset: the offset in the extension context of the pointer
+                       through which the extension accesses the column
+        initRecord: initializes the record at an index, given the context
+*/
+
+typedef struct
+{
+    int  columnFlags;
+    size_t recordSize;
+    size_t contextOffset;
+    void (*initRecord)(void *, int);
+} graphColumn;
+
+typedef graphColumn * graphColumnP;
+
 typedef struct
 {
     int  moduleID;
     void *context;
     void *(*dupContext)(void *, void *);
     void (*freeContext)(void *);
+    size_t (*getMemoryUsage)(void *);
 
     graphFunctionTableP functions;
 
+    graphColumnP columns;
+    int numColumns;
+
     struct graphExtension *next;
 } graphExtension;
 
+/********************************************************************
+ graphColumnBlock
+ The memory holding the columns of one kind of all extensions of a graph
+        base: the block, or NULL if there are no such columns
+        size: the size of the block
+*/
+
+typedef struct
+{
+    void *base;
+    size_t size;
+} graphColumnBlock;
+
 typedef graphExtension * graphExtensionP;
 
 #ifdef __cplusplus
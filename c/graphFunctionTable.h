@@ -40,6 +40,7 @@ typedef struct
         int  (*fpInitGraph)();
         void (*fpReinitializeGraph)();
         int  (*fpEnsureArcCapacity)();
+        int  (*fpTrimGraph)();
         int  (*fpSortVertices)();
 
         int  (*fpReadPostprocess)();
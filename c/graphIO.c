@@ -13,6 +13,7 @@ See the LICENSE.TXT file for licensing information.
 
 int  _ReadAdjMatrix(graphP theGraph, FILE *Infile);
 int  _ReadAdjList(graphP theGraph, FILE *Infile);
+int  _CountArcs(graphP theGraph, FILE *Infile, char Ch, int *pArcCount);
 int  _WriteAdjList(graphP theGraph, FILE *Outfile);
 int  _WriteAdjMatrix(graphP theGraph, FILE *Outfile);
 int  _WriteDebugInfo(graphP theGraph, FILE *Outfile);
@@ -296,6 +297,223 @@ int  _ReadLEDAGraph(graphP theGraph, FILE *Infile)
     return OK;
 }
 
+/********************************************************************
+ _CountAdjMatrixArcs()
+ Counting pre-pass for _ReadAdjMatrix(): two arcs per set flag.
+ ********************************************************************/
+
+int  _CountAdjMatrixArcs(graphP theGraph, FILE *Infile, long long *pArcCount)
+{
+	int N, v, w, Flag;
+
+    if (fscanf(Infile, " %d ", &N) != 1 || N <= 0)
+        return NOTOK;
+
+    for (v = 0; v < N; v++)
+         for (w = v+1; w < N; w++)
+         {
+              if (fscanf(Infile, " %1d", &Flag) != 1)
+                  return NOTOK;
+              if (Flag)
+                  *pArcCount += 2;
+         }
+
+    return OK;
+}
+
+/********************************************************************
+ _CountAdjListArcs()
+ Counting pre-pass for _ReadAdjList().  It parses the file the same
+ way, and it counts the arcs the reader will create: two for each
+ adjacency to a succeeding vertex, and two for each adjacency to a
+ preceding vertex W unless W's list held a not yet matched adjacency
+ to the current vertex (i.e. unless the edge is undirected).
+
+ To detect the matches without a graph, the adjacencies to succeeding
+ vertices are kept as singly linked lists of source vertices, one list
+ per target vertex, and the sources in the current vertex's list are
+ marked before its adjacencies are read.  A mark is consumed by its
+ match, just as the reader consumes the matched adjacency node.
+
+ Returns OK, or NOTOK on memory or file content errors, in which case
+         the reader will report the error (or the default capacity is used)
+ ********************************************************************/
+
+int  _CountAdjListArcs(graphP theGraph, FILE *Infile, long long *pArcCount)
+{
+     int N, v, W, e, indexValue, numSources=0, sourcesSize=0;
+     int *head=NULL, *mark=NULL, *sources=NULL, *tmp;
+     int zeroBased = FALSE, RetVal = OK;
+
+     fgetc(Infile);                             /* Skip the N= */
+     fgetc(Infile);
+     if (fscanf(Infile, " %d ", &N) != 1 || N <= 0)
+         return NOTOK;
+
+     // The arrays are indexed by vertex, so they include the positions
+     // below the first vertex to avoid index translation
+     head = (int *) gp_ReallocMemory(theGraph, NULL, (gp_GetFirstVertex(theGraph) + N) * sizeof(int));
+     mark = (int *) gp_ReallocMemory(theGraph, NULL, (gp_GetFirstVertex(theGraph) + N) * sizeof(int));
+     if (head == NULL || mark == NULL)
+         RetVal = NOTOK;
+     else
+     {
+         for (v = 0; v < gp_GetFirstVertex(theGraph) + N; v++)
+              head[v] = mark[v] = -1;
+     }
+
+     for (v = gp_GetFirstVertex(theGraph); RetVal == OK && v < gp_GetFirstVertex(theGraph) + N; v++)
+     {
+          // Read the vertex number and skip the colon after it
+          if (fscanf(Infile, "%d", &indexValue) != 1)
+          {
+        	  RetVal = NOTOK;
+        	  break;
+          }
+
+          if (indexValue == 0 && v == gp_GetFirstVertex(theGraph))
+        	  zeroBased = TRUE;
+          indexValue += zeroBased ? gp_GetFirstVertex(theGraph) : 0;
+
+          if (indexValue != v)
+          {
+        	  RetVal = NOTOK;
+        	  break;
+          }
+
+          fgetc(Infile);
+
+          // Mark the preceding vertices whose lists contained v
+          for (e = head[v]; e != -1; e = sources[2*e+1])
+        	  mark[sources[2*e]] = v;
+
+          // Read the adjacency list
+          while (1)
+          {
+             if (fscanf(Infile, " %d ", &W) != 1)
+             {
+            	 RetVal = NOTOK;
+            	 break;
+             }
+             W += zeroBased ? gp_GetFirstVertex(theGraph) : 0;
+
+             // A value below the valid range indicates the adjacency list end
+             if (W < gp_GetFirstVertex(theGraph))
+            	 break;
+
+             // Loop edges and values above the valid range are errors
+             if (W >= gp_GetFirstVertex(theGraph) + N || W == v)
+             {
+            	 RetVal = NOTOK;
+            	 break;
+             }
+
+             // An adjacency to a succeeding vertex is an edge, and v is
+             // recorded as a source that W's list may match
+             if (v < W)
+             {
+            	 if (numSources == sourcesSize)
+            	 {
+            		 sourcesSize = sourcesSize > 0 ? 2*sourcesSize : 64;
+            		 if ((tmp = (int *) gp_ReallocMemory(theGraph, sources, 2 * sourcesSize * sizeof(int))) == NULL)
+            		 {
+            			 RetVal = NOTOK;
+            			 break;
+            		 }
+            		 sources = tmp;
+            	 }
+            	 sources[2*numSources] = v;
+            	 sources[2*numSources+1] = head[W];
+            	 head[W] = numSources++;
+            	 *pArcCount += 2;
+             }
+
+             // An adjacency to a preceding vertex completes an undirected
+             // edge if W's list contained v, or else it is a directed edge
+             else if (mark[W] == v)
+            	 mark[W] = -1;
+             else
+            	 *pArcCount += 2;
+          }
+     }
+
+     gp_FreeMemory(theGraph, head);
+     gp_FreeMemory(theGraph, mark);
+     gp_FreeMemory(theGraph, sources);
+
+     return RetVal;
+}
+
+/********************************************************************
+ _CountLEDAArcs()
+ Counting pre-pass for _ReadLEDAGraph(): two arcs per edge that is
+ not a loop.  The count is exact for the simple graphs the format is
+ documented to contain; parallel edges, which the reader omits, make
+ it an upper bound.
+ ********************************************************************/
+
+int  _CountLEDAArcs(graphP theGraph, FILE *Infile, long long *pArcCount)
+{
+	char Line[256];
+	int N, M, m, u, v;
+
+    /* Skip the lines that say LEDA.GRAPH and give the node and edge types */
+    fgets(Line, 255, Infile);
+    fgets(Line, 255, Infile);
+    fgets(Line, 255, Infile);
+
+    /* Read the number of vertices N, then skip N. */
+    if (fgets(Line, 255, Infile) == NULL || sscanf(Line, " %d", &N) != 1 || N <= 0)
+        return NOTOK;
+
+    for (v = 0; v < N; v++)
+        fgets(Line, 255, Infile);
+
+    /* Read the number of edges, then count the non-loop edges */
+    if (fgets(Line, 255, Infile) == NULL || sscanf(Line, " %d", &M) != 1)
+        return NOTOK;
+
+    for (m = 0; m < M; m++)
+    {
+        if (fgets(Line, 255, Infile) == NULL || sscanf(Line, " %d %d", &u, &v) != 2)
+            return NOTOK;
+        if (u != v)
+            *pArcCount += 2;
+    }
+
+    return OK;
+}
+
+/********************************************************************
+ _CountArcs()
+ Makes a counting pass over the graph in Infile, whose format is given
+ by its first character Ch (as in gp_Read()), to obtain the number of
+ arcs the corresponding read function will create.  The pass leaves
+ the file position wherever it stopped; the caller rewinds.
+
+ Returns OK with the count in pArcCount (at least 2, since the arc
+         capacity must be positive), or NOTOK if the count could not be
+         obtained or exceeds the graph's index range
+ ********************************************************************/
+
+int  _CountArcs(graphP theGraph, FILE *Infile, char Ch, int *pArcCount)
+{
+long long arcCount = 0;
+int RetVal;
+
+     if (Ch == 'N')
+          RetVal = _CountAdjListArcs(theGraph, Infile, &arcCount);
+     else if (Ch == 'L')
+          RetVal = _CountLEDAArcs(theGraph, Infile, &arcCount);
+     else RetVal = _CountAdjMatrixArcs(theGraph, Infile, &arcCount);
+
+     if (RetVal != OK || gp_GetFirstEdge(theGraph) + arcCount > GRAPHINDEX_MAX)
+          return NOTOK;
+
+     *pArcCount = arcCount > 0 ? (int) arcCount : 2;
+     return OK;
+}
+
 /********************************************************************
  gp_Read()
  Opens the given file, determines whether it is in adjacency list or
@@ -303,6 +521,15 @@ int  _ReadLEDAGraph(graphP theGraph, FILE *Infile)
  calls the appropriate read function, then closes the file and returns
  the graph.
 
+ Unless the file is stdin, which cannot be rewound, a counting pass is
+ made over the file first, and the arc capacity is ensured to be the
+ exact number of arcs the graph needs before gp_InitGraph() allocates
+ the edge records (and before attached extensions allocate their
+ parallel edge data), unless the caller has already ensured more.
+ So no edges are dropped as too many, and no edge storage is spent
+ beyond the graph's edges.  From stdin, the default arc capacity is
+ used as before.
+
  Digraphs and loop edges are not supported in the adjacency matrix format,
  which is upper triangular.
 
@@ -327,6 +554,20 @@ int RetVal;
 
      Ch = (char) fgetc(Infile);
      ungetc(Ch, Infile);
+
+     // Size the edge storage exactly when the file can be rewound and the
+     // graph has not been initialized.  If the count fails, the read below
+     // uses the default capacity and reports any file content error.
+     if (Infile != stdin && theGraph->N == 0)
+     {
+    	 int arcCount;
+
+    	 if (_CountArcs(theGraph, Infile, Ch, &arcCount) == OK)
+    		 gp_EnsureArcCapacity(theGraph, arcCount);
+
+    	 fseek(Infile, 0, SEEK_SET);
+     }
+
      if (Ch == 'N')
           RetVal = _ReadAdjList(theGraph, Infile);
      else if (Ch == 'L')
@@ -345,7 +586,7 @@ int RetVal;
 
          if (filePos < fileSize)
          {
-            extraData = malloc(fileSize - filePos + 1);
+            extraData = gp_ReallocMemory(theGraph, NULL, fileSize - filePos + 1);
             fread(extraData, fileSize - filePos, 1, Infile);
          }
 /*// Useful for quick debugging of IO extensibility
@@ -362,7 +603,7 @@ int RetVal;
          if (extraData != NULL)
          {
              RetVal = theGraph->functions.fpReadPostprocess(theGraph, extraData, fileSize - filePos);
-             free((void *) extraData);
+             gp_FreeMemory(theGraph, extraData);
          }
      }
 
@@ -432,11 +673,11 @@ int  v, e, K;
 char *Row = NULL;
 
      if (theGraph != NULL)
-         Row = (char *) malloc((theGraph->N+1)*sizeof(char));
+         Row = (char *) gp_ReallocMemory(theGraph, NULL, (theGraph->N+1)*sizeof(char));
 
      if (Row==NULL || theGraph==NULL || Outfile==NULL)
      {
-         if (Row != NULL) free(Row);
+         if (Row != NULL) gp_FreeMemory(theGraph, Row);
          return NOTOK;
      }
 
@@ -464,7 +705,7 @@ char *Row = NULL;
           fprintf(Outfile, "%s\n", Row);
      }
 
-     free(Row);
+     gp_FreeMemory(theGraph, Row);
      return OK;
 }
 
@@ -626,6 +867,10 @@ int RetVal;
      if (theGraph == NULL || FileName == NULL)
     	 return NOTOK;
 
+     // The debug info includes the vertexInfo released by gp_Trim()
+     if (Mode == WRITE_DEBUGINFO && gp_IsTrimmed(theGraph))
+    	 return NOTOK;
+
      if (strcmp(FileName, "nullwrite") == 0)
     	  return OK;
 
@@ -663,7 +908,7 @@ int RetVal;
          {
              if (!fwrite(extraData, extraDataSize, 1, Outfile))
                  RetVal = NOTOK;
-             free(extraData);
+             gp_FreeMemory(theGraph, extraData);
          }
      }
 
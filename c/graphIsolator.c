@@ -70,6 +70,8 @@ int  RetVal;
 
      if (_ChooseTypeOfNonplanarityMinor(theGraph, v, R) != OK)
          return NOTOK;
+     gp_TraceEvent(theGraph, TRACEEVENT_MINORCHOSEN, v, theGraph->IC.r, theGraph->IC.w,
+                   theGraph->IC.minorType);
 
      if (_InitializeIsolatorContext(theGraph) != OK)
          return NOTOK;
@@ -49,6 +49,8 @@ int X, Y, XPrevLink, YPrevLink;
 
      if (_ChooseTypeOfNonOuterplanarityMinor(theGraph, v, R) != OK)
          return NOTOK;
+     gp_TraceEvent(theGraph, TRACEEVENT_MINORCHOSEN, v, theGraph->IC.r, theGraph->IC.w,
+                   theGraph->IC.minorType);
 
 /* Minors A and B result in the desired K_{2,3} homeomorph,
     so we isolate it and return NONEMBEDDABLE. */
@@ -15,6 +15,9 @@ extern "C" {
 
 typedef struct
 {
+    // The graph that this context augments
+    graphP theGraph;
+
     // Overloaded function pointers
     graphFunctionTable functions;
 
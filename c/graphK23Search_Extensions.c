@@ -27,6 +27,7 @@ int  _K23Search_CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
 
 void *_K23Search_DupContext(void *pContext, void *theGraph);
 void _K23Search_FreeContext(void *);
+size_t _K23Search_GetMemoryUsage(void *);
 
 /****************************************************************************
  * K23SEARCH_ID - the variable used to hold the integer identifier for this
@@ -56,12 +57,15 @@ int  gp_AttachK23Search(graphP theGraph)
      }
 
      // Allocate a new extension context
-     context = (K23SearchContext *) malloc(sizeof(K23SearchContext));
+     context = (K23SearchContext *) gp_AllocMemory(theGraph, sizeof(K23SearchContext));
      if (context == NULL)
      {
          return NOTOK;
      }
 
+     // Save a pointer to theGraph in the context
+     context->theGraph = theGraph;
+
      // Put the overload functions into the context function table.
      // gp_AddExtension will overload the graph's functions with these, and
      // return the base function pointers in the context function table
@@ -75,7 +79,7 @@ int  gp_AttachK23Search(graphP theGraph)
      // Store the K23 search context, including the data structure and the
      // function pointers, as an extension of the graph
      if (gp_AddExtension(theGraph, &K23SEARCH_ID, (void *) context,
-                         _K23Search_DupContext, _K23Search_FreeContext,
+                         _K23Search_DupContext, _K23Search_FreeContext, _K23Search_GetMemoryUsage,
                          &context->functions) != OK)
      {
          _K23Search_FreeContext(context);
@@ -101,23 +105,37 @@ int gp_DetachK23Search(graphP theGraph)
 void *_K23Search_DupContext(void *pContext, void *theGraph)
 {
      K23SearchContext *context = (K23SearchContext *) pContext;
-     K23SearchContext *newContext = (K23SearchContext *) malloc(sizeof(K23SearchContext));
+     K23SearchContext *newContext = (K23SearchContext *) gp_AllocMemory((graphP) theGraph, sizeof(K23SearchContext));
 
      if (newContext != NULL)
      {
          *newContext = *context;
+
+         newContext->theGraph = (graphP) theGraph;
      }
 
      return newContext;
 }
 
+/********************************************************************
+ _K23Search_GetMemoryUsage()
+ Returns the bytes allocated for the context and its structures.
+ ********************************************************************/
+
+size_t _K23Search_GetMemoryUsage(void *pContext)
+{
+     return sizeof(K23SearchContext);
+}
+
 /********************************************************************
  _K23Search_FreeContext()
  ********************************************************************/
 
 void _K23Search_FreeContext(void *pContext)
 {
-     free(pContext);
+     K23SearchContext *context = (K23SearchContext *) pContext;
+
+     gp_FreeMemory(context->theGraph, pContext);
 }
 
 /********************************************************************
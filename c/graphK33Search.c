@@ -21,7 +21,7 @@ extern int  _FillVertexVisitedInfoInBicomp(graphP theGraph, int BicompRoot, int
 
 //extern int  _GetBicompSize(graphP theGraph, int BicompRoot);
 extern int  _HideInternalEdges(graphP theGraph, int vertex);
-extern int  _RestoreInternalEdges(graphP theGraph, int stackBottom);
+extern int  _RestoreInternalEdges(graphP theGraph, stackIndex stackBottom);
 extern int  _ClearInvertedFlagsInBicomp(graphP theGraph, int BicompRoot);
 extern int  _ComputeArcType(graphP theGraph, int a, int b, int edgeType);
 extern int  _SetEdgeType(graphP theGraph, int u, int v);
@@ -109,6 +109,8 @@ int tempResult;
 
      else R = IC->r;
 
+     gp_TraceEvent(theGraph, TRACEEVENT_MINORCHOSEN, v, R, IC->w, IC->minorType);
+
 /* Minors A to D result in the desired K_{3,3} homeomorph,
     so we isolate it and return NONEMBEDDABLE. */
 
@@ -739,12 +741,16 @@ int  R, Rout, Z, ZPrevLink;
      if (sp_IsEmpty(theGraph->theStack))
          return OK;
 
-/* Create a copy of the embedding stack */
+/* Create a copy of the embedding stack, outside of any arena since it
+   is only temporary */
 
-     tempStack = sp_Duplicate(theGraph->theStack);
+     tempStack = sp_NewAt(gp_ReallocMemory(theGraph, NULL, sp_SizeOf(sp_GetCapacity(theGraph->theStack))),
+                          sp_GetCapacity(theGraph->theStack));
      if (tempStack == NULL)
          return NOTOK;
 
+     sp_CopyContent(tempStack, theGraph->theStack);
+
 /* Search the copy of the embedding stack for a merge blocked vertex */
 
      while (!sp_IsEmpty(tempStack))
@@ -760,7 +766,7 @@ int  R, Rout, Z, ZPrevLink;
          }
      }
 
-     sp_Free(&tempStack);
+     gp_FreeMemory(theGraph, tempStack);
      return OK;
 }
 
@@ -838,6 +844,7 @@ isolatorContextP IC = &theGraph->IC;
 
      if (_ChooseTypeOfNonplanarityMinor(theGraph, IC->v, R) != OK)
          return NOTOK;
+     gp_TraceEvent(theGraph, TRACEEVENT_MINORCHOSEN, IC->v, IC->r, IC->w, IC->minorType);
 
      IC->ux = _GetLeastAncestorConnection(theGraph, IC->x);
      IC->uy = _GetLeastAncestorConnection(theGraph, IC->y);
@@ -899,7 +906,7 @@ int  _TestForLowXYPath(graphP theGraph)
 {
 isolatorContextP IC = &theGraph->IC;
 int  result;
-int  stackBottom;
+stackIndex stackBottom;
 
 /* Clear the previously marked X-Y path */
 
@@ -1486,7 +1493,7 @@ int  _K33Search_DeleteEdge(graphP theGraph, K33SearchContext *context, int e, in
 int  _K33Search_DeleteUnmarkedEdgesInBicomp(graphP theGraph, K33SearchContext *context, int BicompRoot)
 {
 int  V, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+stackIndex stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -5,6 +5,7 @@ See the LICENSE.TXT file for licensing information.
 */
 
 #include <stdlib.h>
+#include <stddef.h>
 
 #include "graphK33Search.private.h"
 #include "graphK33Search.h"
@@ -22,10 +23,11 @@ extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
 
 void _K33Search_ClearStructures(K33SearchContext *context);
 int  _K33Search_CreateStructures(K33SearchContext *context);
-int  _K33Search_InitStructures(K33SearchContext *context);
 
 void _K33Search_InitEdgeRec(K33SearchContext *context, int e);
+void _K33Search_InitEdgeColumnRec(void *pContext, int e);
 void _K33Search_InitVertexInfo(K33SearchContext *context, int v);
+void _K33Search_InitVertexColumnRec(void *pContext, int v);
 
 /* Forward declarations of overloading functions */
 
@@ -42,12 +44,13 @@ int  _K33Search_CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
 
 int  _K33Search_InitGraph(graphP theGraph, int N);
 void _K33Search_ReinitializeGraph(graphP theGraph);
-int  _K33Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
+int  _K33Search_TrimGraph(graphP theGraph);
 
 /* Forward declarations of functions used by the extension system */
 
 void *_K33Search_DupContext(void *pContext, void *theGraph);
 void _K33Search_FreeContext(void *);
+size_t _K33Search_GetMemoryUsage(void *);
 
 /****************************************************************************
  * K33SEARCH_ID - the variable used to hold the integer identifier for this
@@ -77,7 +80,7 @@ int  gp_AttachK33Search(graphP theGraph)
      }
 
      // Allocate a new extension context
-     context = (K33SearchContext *) malloc(sizeof(K33SearchContext));
+     context = (K33SearchContext *) gp_AllocMemory(theGraph, sizeof(K33SearchContext));
      if (context == NULL)
      {
          return NOTOK;
@@ -105,20 +108,33 @@ int  gp_AttachK33Search(graphP theGraph)
 
      context->functions.fpInitGraph = _K33Search_InitGraph;
      context->functions.fpReinitializeGraph = _K33Search_ReinitializeGraph;
-     context->functions.fpEnsureArcCapacity = _K33Search_EnsureArcCapacity;
+     context->functions.fpTrimGraph = _K33Search_TrimGraph;
 
      _K33Search_ClearStructures(context);
 
      // Store the K33 search context, including the data structure and the
      // function pointers, as an extension of the graph
      if (gp_AddExtension(theGraph, &K33SEARCH_ID, (void *) context,
-                         _K33Search_DupContext, _K33Search_FreeContext,
+                         _K33Search_DupContext, _K33Search_FreeContext, _K33Search_GetMemoryUsage,
                          &context->functions) != OK)
      {
          _K33Search_FreeContext(context);
          return NOTOK;
      }
 
+     // The parallel arrays for edges and vertices are columns managed by
+     // the core, which allocates them now if the graph is initialized
+     if (gp_AddExtensionColumn(theGraph, K33SEARCH_ID, COLUMNFLAGS_EDGE | COLUMNFLAGS_NILINIT,
+                               sizeof(K33Search_EdgeRec), offsetof(K33SearchContext, E),
+                               _K33Search_InitEdgeColumnRec) != OK ||
+         gp_AddExtensionColumn(theGraph, K33SEARCH_ID, COLUMNFLAGS_VERTEX | COLUMNFLAGS_NILINIT,
+                               sizeof(K33Search_VertexInfo), offsetof(K33SearchContext, VI),
+                               _K33Search_InitVertexColumnRec) != OK)
+     {
+         gp_DetachK33Search(theGraph);
+         return NOTOK;
+     }
+
      // Create the K33-specific structures if the size of the graph is known
      // Attach functions are always invoked after gp_New(), but if a graph
      // extension must be attached before gp_Read(), then the attachment
@@ -127,8 +143,7 @@ int  gp_AttachK33Search(graphP theGraph)
      // which case N > 0
      if (theGraph->N > 0)
      {
-         if (_K33Search_CreateStructures(context) != OK ||
-             _K33Search_InitStructures(context) != OK)
+         if (_K33Search_CreateStructures(context) != OK)
          {
              _K33Search_FreeContext(context);
              return NOTOK;
@@ -156,7 +171,8 @@ void _K33Search_ClearStructures(K33SearchContext *context)
     if (!context->initialized)
     {
         // Before initialization, the pointers are stray, not NULL
-        // Once NULL or allocated, free() or LCFree() can do the job
+        // Once NULL or allocated, gp_FreeMemory() or gp_FreeListCollection() can do the job
+        // The E and VI columns are only set here; the core manages them
         context->E = NULL;
         context->VI = NULL;
 
@@ -168,45 +184,31 @@ void _K33Search_ClearStructures(K33SearchContext *context)
     }
     else
     {
-        if (context->E != NULL)
-        {
-            free(context->E);
-            context->E = NULL;
-        }
-        if (context->VI != NULL)
-        {
-            free(context->VI);
-            context->VI = NULL;
-        }
-
-        LCFree(&context->separatedDFSChildLists);
+        gp_FreeListCollection(context->theGraph, &context->separatedDFSChildLists);
 		if (context->buckets != NULL)
 		{
-			free(context->buckets);
+			gp_FreeMemory(context->theGraph, context->buckets);
 			context->buckets = NULL;
 		}
-		LCFree(&context->bin);
+		gp_FreeListCollection(context->theGraph, &context->bin);
     }
 }
 
 /********************************************************************
  _K33Search_CreateStructures()
- Create uninitialized structures for the vertex and edge
- levels, and initialized structures for the graph level
+ Create the initialized structures for the graph level.  The vertex
+ and edge level columns are created by the core.
  ********************************************************************/
 int  _K33Search_CreateStructures(K33SearchContext *context)
 {
      int VIsize = gp_PrimaryVertexIndexBound(context->theGraph);
-     int Esize = gp_EdgeIndexBound(context->theGraph);
 
      if (context->theGraph->N <= 0)
          return NOTOK;
 
-     if ((context->E = (K33Search_EdgeRecP) malloc(Esize*sizeof(K33Search_EdgeRec))) == NULL ||
-         (context->VI = (K33Search_VertexInfoP) malloc(VIsize*sizeof(K33Search_VertexInfo))) == NULL ||
-		 (context->separatedDFSChildLists = LCNew(VIsize)) == NULL ||
-		 (context->buckets = (int *) malloc(VIsize * sizeof(int))) == NULL ||
-		 (context->bin = LCNew(VIsize)) == NULL
+     if ((context->separatedDFSChildLists = gp_NewListCollection(context->theGraph, VIsize)) == NULL ||
+		 (context->buckets = (int *) gp_AllocMemory(context->theGraph, VIsize * sizeof(int))) == NULL ||
+		 (context->bin = gp_NewListCollection(context->theGraph, VIsize)) == NULL
         )
      {
          return NOTOK;
@@ -215,32 +217,6 @@ int  _K33Search_CreateStructures(K33SearchContext *context)
      return OK;
 }
 
-/********************************************************************
- _K33Search_InitStructures()
- ********************************************************************/
-int  _K33Search_InitStructures(K33SearchContext *context)
-{
-#if NIL == 0 || NIL == -1
-	memset(context->VI, NIL_CHAR, gp_PrimaryVertexIndexBound(context->theGraph) * sizeof(K33Search_VertexInfo));
-	memset(context->E, NIL_CHAR, gp_EdgeIndexBound(context->theGraph) * sizeof(K33Search_EdgeRec));
-#else
-	 graphP theGraph = context->theGraph;
-     int v, e, Esize;
-
-     if (theGraph->N <= 0)
-         return OK;
-
-     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
-          _K33Search_InitVertexInfo(context, v);
-
-     Esize = gp_EdgeIndexBound(theGraph);
-     for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
-          _K33Search_InitEdgeRec(context, e);
-#endif
-
-     return OK;
-}
-
 /********************************************************************
  ********************************************************************/
 
@@ -257,13 +233,11 @@ int  _K33Search_InitGraph(graphP theGraph, int N)
 	if (theGraph->arcCapacity == 0)
 		theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
 
-	if (_K33Search_CreateStructures(context) != OK ||
-		_K33Search_InitStructures(context) != OK)
+	if (_K33Search_CreateStructures(context) != OK)
 		return NOTOK;
 
-	context->functions.fpInitGraph(theGraph, N);
-
-    return OK;
+	// The base function also creates the columns of the extension
+	return context->functions.fpInitGraph(theGraph, N);
 }
 
 /********************************************************************
@@ -276,28 +250,33 @@ void _K33Search_ReinitializeGraph(graphP theGraph)
 
     if (context != NULL)
     {
-		// Reinitialize the graph
+		// Reinitialize the graph, which includes the columns of the extension
 		context->functions.fpReinitializeGraph(theGraph);
 
 		// Do the reinitialization that is specific to this module
-		_K33Search_InitStructures(context);
 		LCReset(context->separatedDFSChildLists);
 		LCReset(context->bin);
     }
 }
 
 /********************************************************************
- The current implementation does not support an increase of arc
- (edge record) capacity once the extension is attached to the graph
- data structure.  This is only due to not being necessary to support.
- For now, it is easy to ensure the correct capacity before attaching
- the extension, but support could be added later if there is some
- reason to do so.
+ _K33Search_TrimGraph()
+ The result of the K3,3 search is the embedding or obstruction in
+ theGraph itself, so all of the extension data is working data.  The
+ base function releases the columns; the other structures are freed here.
  ********************************************************************/
 
-int  _K33Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
+int  _K33Search_TrimGraph(graphP theGraph)
 {
-	return NOTOK;
+    K33SearchContext *context = NULL;
+    gp_FindExtension(theGraph, K33SEARCH_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    _K33Search_ClearStructures(context);
+
+    return context->functions.fpTrimGraph(theGraph);
 }
 
 /********************************************************************
@@ -307,13 +286,10 @@ int  _K33Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
 void *_K33Search_DupContext(void *pContext, void *theGraph)
 {
      K33SearchContext *context = (K33SearchContext *) pContext;
-     K33SearchContext *newContext = (K33SearchContext *) malloc(sizeof(K33SearchContext));
+     K33SearchContext *newContext = (K33SearchContext *) gp_AllocMemory((graphP) theGraph, sizeof(K33SearchContext));
 
      if (newContext != NULL)
      {
-         int VIsize = gp_PrimaryVertexIndexBound((graphP) theGraph);
-         int Esize = gp_EdgeIndexBound((graphP) theGraph);
-
          *newContext = *context;
 
          newContext->theGraph = (graphP) theGraph;
@@ -328,8 +304,7 @@ void *_K33Search_DupContext(void *pContext, void *theGraph)
                  return NULL;
              }
 
-             memcpy(newContext->E, context->E, Esize*sizeof(K33Search_EdgeRec));
-             memcpy(newContext->VI, context->VI, VIsize*sizeof(K33Search_VertexInfo));
+             // The columns are copied by gp_CopyExtensions()
              LCCopy(newContext->separatedDFSChildLists, context->separatedDFSChildLists);
          }
      }
@@ -337,6 +312,26 @@ void *_K33Search_DupContext(void *pContext, void *theGraph)
      return newContext;
 }
 
+/********************************************************************
+ _K33Search_GetMemoryUsage()
+ Returns the bytes allocated for the context and its structures.
+ ********************************************************************/
+
+size_t _K33Search_GetMemoryUsage(void *pContext)
+{
+     K33SearchContext *context = (K33SearchContext *) pContext;
+     size_t usage = sizeof(K33SearchContext);
+
+     // The columns are counted by gp_GetMemoryUsage()
+     if (context->buckets != NULL)
+         usage += gp_PrimaryVertexIndexBound(context->theGraph) * sizeof(int);
+
+     usage += LCGetMemoryUsage(context->separatedDFSChildLists) +
+              LCGetMemoryUsage(context->bin);
+
+     return usage;
+}
+
 /********************************************************************
  _K33Search_FreeContext()
  ********************************************************************/
@@ -346,7 +341,7 @@ void _K33Search_FreeContext(void *pContext)
      K33SearchContext *context = (K33SearchContext *) pContext;
 
      _K33Search_ClearStructures(context);
-     free(pContext);
+     gp_FreeMemory(context->theGraph, pContext);
 }
 
 /********************************************************************
@@ -609,6 +604,16 @@ void _K33Search_InitEdgeRec(K33SearchContext *context, int e)
     context->E[e].pathConnector = NIL;
 }
 
+/********************************************************************
+ _K33Search_InitEdgeColumnRec()
+ The initRecord of the edge column, given to gp_AddExtensionColumn()
+ ********************************************************************/
+
+void _K33Search_InitEdgeColumnRec(void *pContext, int e)
+{
+    _K33Search_InitEdgeRec((K33SearchContext *) pContext, e);
+}
+
 /********************************************************************
  ********************************************************************/
 
@@ -619,6 +624,16 @@ void _K33Search_InitVertexInfo(K33SearchContext *context, int v)
     context->VI[v].mergeBlocker = NIL;
 }
 
+/********************************************************************
+ _K33Search_InitVertexColumnRec()
+ The initRecord of the vertex column, given to gp_AddExtensionColumn()
+ ********************************************************************/
+
+void _K33Search_InitVertexColumnRec(void *pContext, int v)
+{
+    _K33Search_InitVertexInfo((K33SearchContext *) pContext, v);
+}
+
 /********************************************************************
  ********************************************************************/
 
@@ -102,6 +102,8 @@ isolatorContextP IC = &theGraph->IC;
 	// Begin by determining whether minor A, B or E is detected
 	if (_K4_ChooseTypeOfNonOuterplanarityMinor(theGraph, v, R) != OK)
 		return NOTOK;
+	gp_TraceEvent(theGraph, TRACEEVENT_MINORCHOSEN, v, theGraph->IC.r, theGraph->IC.w,
+				  theGraph->IC.minorType);
 
     // Minor A indicates the existence of K_{2,3} homeomorphs, but
     // we run additional tests to see whether we can either find an
@@ -1027,7 +1029,7 @@ int  _K4_DeleteEdge(graphP theGraph, K4SearchContext *context, int e, int nextLi
 int  _K4_DeleteUnmarkedEdgesInBicomp(graphP theGraph, K4SearchContext *context, int BicompRoot)
 {
 int  V, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+stackIndex stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -5,6 +5,7 @@ See the LICENSE.TXT file for licensing information.
 */
 
 #include <stdlib.h>
+#include <stddef.h>
 
 #include "graphK4Search.private.h"
 #include "graphK4Search.h"
@@ -22,10 +23,9 @@ extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
 /* Forward declarations of local functions */
 
 void _K4Search_ClearStructures(K4SearchContext *context);
-int  _K4Search_CreateStructures(K4SearchContext *context);
-int  _K4Search_InitStructures(K4SearchContext *context);
 
 void _K4Search_InitEdgeRec(K4SearchContext *context, int e);
+void _K4Search_InitEdgeColumnRec(void *pContext, int e);
 
 /* Forward declarations of overloading functions */
 int  _K4Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R);
@@ -33,14 +33,11 @@ int  _K4Search_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult)
 int  _K4Search_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph);
 int  _K4Search_CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
 
-int  _K4Search_InitGraph(graphP theGraph, int N);
-void _K4Search_ReinitializeGraph(graphP theGraph);
-int  _K4Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
-
 /* Forward declarations of functions used by the extension system */
 
 void *_K4Search_DupContext(void *pContext, void *theGraph);
 void _K4Search_FreeContext(void *);
+size_t _K4Search_GetMemoryUsage(void *);
 
 /****************************************************************************
  * K4SEARCH_ID - the variable used to hold the integer identifier for this
@@ -70,7 +67,7 @@ int  gp_AttachK4Search(graphP theGraph)
      }
 
      // Allocate a new extension context
-     context = (K4SearchContext *) malloc(sizeof(K4SearchContext));
+     context = (K4SearchContext *) gp_AllocMemory(theGraph, sizeof(K4SearchContext));
      if (context == NULL)
      {
          return NOTOK;
@@ -91,36 +88,29 @@ int  gp_AttachK4Search(graphP theGraph)
      context->functions.fpCheckEmbeddingIntegrity = _K4Search_CheckEmbeddingIntegrity;
      context->functions.fpCheckObstructionIntegrity = _K4Search_CheckObstructionIntegrity;
 
-     context->functions.fpInitGraph = _K4Search_InitGraph;
-     context->functions.fpReinitializeGraph = _K4Search_ReinitializeGraph;
-     context->functions.fpEnsureArcCapacity = _K4Search_EnsureArcCapacity;
-
      _K4Search_ClearStructures(context);
 
      // Store the K4 search context, including the data structure and the
      // function pointers, as an extension of the graph
      if (gp_AddExtension(theGraph, &K4SEARCH_ID, (void *) context,
-                         _K4Search_DupContext, _K4Search_FreeContext,
+                         _K4Search_DupContext, _K4Search_FreeContext, _K4Search_GetMemoryUsage,
                          &context->functions) != OK)
      {
          _K4Search_FreeContext(context);
          return NOTOK;
      }
 
-     // Create the K4-specific structures if the size of the graph is known
-     // Attach functions are always invoked after gp_New(), but if a graph
-     // extension must be attached before gp_Read(), then the attachment
-     // also happens before gp_InitGraph(), which means N==0.
-     // However, sometimes a feature is attached after gp_InitGraph(), in
-     // which case N > 0
-     if (theGraph->N > 0)
+     // The parallel array for edges is a column managed by the core, which
+     // allocates it now if gp_InitGraph() has already been invoked, and
+     // otherwise when it is.  The K4 search has no other structures that
+     // depend on the size of the graph, so it needs no overloads of the
+     // initialization functions.
+     if (gp_AddExtensionColumn(theGraph, K4SEARCH_ID, COLUMNFLAGS_EDGE | COLUMNFLAGS_NILINIT,
+                               sizeof(K4Search_EdgeRec), offsetof(K4SearchContext, E),
+                               _K4Search_InitEdgeColumnRec) != OK)
      {
-         if (_K4Search_CreateStructures(context) != OK ||
-             _K4Search_InitStructures(context) != OK)
-         {
-             _K4Search_FreeContext(context);
-             return NOTOK;
-         }
+         gp_DetachK4Search(theGraph);
+         return NOTOK;
      }
 
      return OK;
@@ -144,7 +134,7 @@ void _K4Search_ClearStructures(K4SearchContext *context)
     if (!context->initialized)
     {
         // Before initialization, the pointers are stray, not NULL
-        // Once NULL or allocated, free() or LCFree() can do the job
+        // The E column is only set here; the core manages it
         context->E = NULL;
 
         context->handlingBlockedBicomp = FALSE;
@@ -153,111 +143,10 @@ void _K4Search_ClearStructures(K4SearchContext *context)
     }
     else
     {
-        if (context->E != NULL)
-        {
-            free(context->E);
-            context->E = NULL;
-        }
         context->handlingBlockedBicomp = FALSE;
     }
 }
 
-/********************************************************************
- _K4Search_CreateStructures()
- Create uninitialized structures for the vertex and edge levels, and
- initialized structures for the graph level
- ********************************************************************/
-int  _K4Search_CreateStructures(K4SearchContext *context)
-{
-     int Esize = gp_EdgeIndexBound(context->theGraph);
-
-     if (context->theGraph->N <= 0)
-         return NOTOK;
-
-     if ((context->E = (K4Search_EdgeRecP) malloc(Esize*sizeof(K4Search_EdgeRec))) == NULL ||
-        0)
-     {
-         return NOTOK;
-     }
-
-     return OK;
-}
-
-/********************************************************************
- _K4Search_InitStructures()
- ********************************************************************/
-int  _K4Search_InitStructures(K4SearchContext *context)
-{
-#if NIL == 0 || NIL == -1
-	memset(context->E, NIL_CHAR, gp_EdgeIndexBound(context->theGraph) * sizeof(K4Search_EdgeRec));
-#else
-    int e, Esize;
-
-     Esize = gp_EdgeIndexBound(context->theGraph);
-     for (e = gp_GetFirstEdge(context->theGraph); e < Esize; e++)
-          _K4Search_InitEdgeRec(context, e);
-#endif
-
-     return OK;
-}
-
-/********************************************************************
- ********************************************************************/
-
-int  _K4Search_InitGraph(graphP theGraph, int N)
-{
-    K4SearchContext *context = NULL;
-    gp_FindExtension(theGraph, K4SEARCH_ID, (void *)&context);
-
-    if (context == NULL)
-        return NOTOK;
-
-    theGraph->N = N;
-	theGraph->NV = N;
-	if (theGraph->arcCapacity == 0)
-		theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
-
-	if (_K4Search_CreateStructures(context) != OK ||
-		_K4Search_InitStructures(context) != OK)
-		return NOTOK;
-
-	context->functions.fpInitGraph(theGraph, N);
-
-    return OK;
-}
-
-/********************************************************************
- ********************************************************************/
-
-void _K4Search_ReinitializeGraph(graphP theGraph)
-{
-    K4SearchContext *context = NULL;
-    gp_FindExtension(theGraph, K4SEARCH_ID, (void *)&context);
-
-    if (context != NULL)
-    {
-		// Reinitialize the graph
-		context->functions.fpReinitializeGraph(theGraph);
-
-		// Do the reinitialization that is specific to this module
-		_K4Search_InitStructures(context);
-    }
-}
-
-/********************************************************************
- The current implementation does not support an increase of arc
- (edge record) capacity once the extension is attached to the graph
- data structure.  This is only due to not being necessary to support.
- For now, it is easy to ensure the correct capacity before attaching
- the extension, but support could be added later if there is some
- reason to do so.
- ********************************************************************/
-
-int  _K4Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
-{
-	return NOTOK;
-}
-
 /********************************************************************
  _K4Search_DupContext()
  ********************************************************************/
@@ -265,33 +154,33 @@ int  _K4Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
 void *_K4Search_DupContext(void *pContext, void *theGraph)
 {
      K4SearchContext *context = (K4SearchContext *) pContext;
-     K4SearchContext *newContext = (K4SearchContext *) malloc(sizeof(K4SearchContext));
+     K4SearchContext *newContext = (K4SearchContext *) gp_AllocMemory((graphP) theGraph, sizeof(K4SearchContext));
 
      if (newContext != NULL)
      {
-         int Esize = gp_EdgeIndexBound((graphP) theGraph);
-
          *newContext = *context;
 
          newContext->theGraph = (graphP) theGraph;
 
+         // The E column is copied by gp_CopyExtensions()
          newContext->initialized = 0;
          _K4Search_ClearStructures(newContext);
-         if (((graphP) theGraph)->N > 0)
-         {
-             if (_K4Search_CreateStructures(newContext) != OK)
-             {
-                 _K4Search_FreeContext(newContext);
-                 return NULL;
-             }
-
-             memcpy(newContext->E, context->E, Esize*sizeof(K4Search_EdgeRec));
-         }
      }
 
      return newContext;
 }
 
+/********************************************************************
+ _K4Search_GetMemoryUsage()
+ Returns the bytes allocated for the context and its structures.
+ ********************************************************************/
+
+size_t _K4Search_GetMemoryUsage(void *pContext)
+{
+     // The E column is counted by gp_GetMemoryUsage()
+     return sizeof(K4SearchContext);
+}
+
 /********************************************************************
  _K4Search_FreeContext()
  ********************************************************************/
@@ -301,7 +190,7 @@ void _K4Search_FreeContext(void *pContext)
      K4SearchContext *context = (K4SearchContext *) pContext;
 
      _K4Search_ClearStructures(context);
-     free(pContext);
+     gp_FreeMemory(context->theGraph, pContext);
 }
 
 /********************************************************************
@@ -312,6 +201,16 @@ void _K4Search_InitEdgeRec(K4SearchContext *context, int e)
     context->E[e].pathConnector = NIL;
 }
 
+/********************************************************************
+ _K4Search_InitEdgeColumnRec()
+ The initRecord of the edge column, given to gp_AddExtensionColumn()
+ ********************************************************************/
+
+void _K4Search_InitEdgeColumnRec(void *pContext, int e)
+{
+    _K4Search_InitEdgeRec((K4SearchContext *) pContext, e);
+}
+
 /********************************************************************
  _K4Search_HandleBlockedBicomp()
  Returns OK if no K4 homeomorph found and blockage cleared (OK to
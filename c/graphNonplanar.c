@@ -14,7 +14,7 @@ extern void _InitIsolatorContext(graphP theGraph);
 extern int  _ClearVisitedFlagsInBicomp(graphP theGraph, int BicompRoot);
 extern int  _ClearVertexTypeInBicomp(graphP theGraph, int BicompRoot);
 extern int  _HideInternalEdges(graphP theGraph, int vertex);
-extern int  _RestoreInternalEdges(graphP theGraph, int stackBottom);
+extern int  _RestoreInternalEdges(graphP theGraph, stackIndex stackBottom);
 
 //extern int  _OrientVerticesInEmbedding(graphP theGraph);
 extern int  _OrientVerticesInBicomp(graphP theGraph, int BicompRoot, int PreserveSigns);
@@ -29,7 +29,7 @@ void _FindActiveVertices(graphP theGraph, int R, int *pX, int *pY);
 int  _FindPertinentVertex(graphP theGraph);
 int  _SetVertexTypesForMarkingXYPath(graphP theGraph);
 
-int  _PopAndUnmarkVerticesAndEdges(graphP theGraph, int Z, int stackBottom);
+int  _PopAndUnmarkVerticesAndEdges(graphP theGraph, int Z, stackIndex stackBottom);
 
 int  _MarkHighestXYPath(graphP theGraph);
 int  _MarkZtoRPath(graphP theGraph);
@@ -363,7 +363,7 @@ int  _SetVertexTypesForMarkingXYPath(graphP theGraph)
  pairs may appear.
  ****************************************************************************/
 
-int  _PopAndUnmarkVerticesAndEdges(graphP theGraph, int Z, int stackBottom)
+int  _PopAndUnmarkVerticesAndEdges(graphP theGraph, int Z, stackIndex stackBottom)
 {
 int  V, e;
 
@@ -467,7 +467,7 @@ int  _MarkHighestXYPath(graphP theGraph)
 {
 int e, Z;
 int R, X, Y, W;
-int stackBottom1, stackBottom2;
+stackIndex stackBottom1, stackBottom2;
 
 /* Initialization */
 
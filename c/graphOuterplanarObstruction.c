@@ -99,6 +99,8 @@ int  RetVal;
 
      if (_ChooseTypeOfNonOuterplanarityMinor(theGraph, v, R) != OK)
          return NOTOK;
+     gp_TraceEvent(theGraph, TRACEEVENT_MINORCHOSEN, v, theGraph->IC.r, theGraph->IC.w,
+                   theGraph->IC.minorType);
 
 /* Find the path connecting the pertinent vertex w with the current vertex v */
 
@@ -0,0 +1,267 @@
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+#define GRAPHPOOL_C
+
+#include <stdlib.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "graph.h"
+#include "graphDrawPlanar.h"
+#include "graphK23Search.h"
+#include "graphK33Search.h"
+#include "graphK4Search.h"
+
+/********************************************************************
+ Graph pool
+
+ A service that embeds many graphs would otherwise allocate each graph
+ with gp_New() and gp_InitGraph(), attach the extension of the algorithm
+ and free it all again per request.  gp_PoolAcquire() instead hands back
+ an initialized graph of the given order with the extension of the given
+ algorithm already attached, reusing an idle graph released earlier by
+ gp_PoolRelease() if there is a matching one.
+
+ Idle graphs are kept in size classes by arc capacity: class K holds the
+ graphs whose arc capacity is at least 2^K and less than 2^(K+1).  The
+ pool creates graphs with the requested arc capacity rounded up to a
+ power of two, so a request is served from its class by any idle graph
+ of the same order and algorithm.  The vertex arrays are sized by N, so
+ the order must match exactly.  At most GRAPHPOOL_CLASSLIMIT idle graphs
+ are kept per class, and gp_PoolClear() frees all of them.
+
+ The pool functions are thread safe.  Graphs are created and reset
+ outside of the pool lock, except for attaching the extension, since
+ the first attachment of an extension assigns its module ID.
+ ********************************************************************/
+
+#define GRAPHPOOL_NUMCLASSES    32
+#define GRAPHPOOL_CLASSLIMIT    16
+
+static graphP poolClasses[GRAPHPOOL_NUMCLASSES];
+static int poolClassSizes[GRAPHPOOL_NUMCLASSES];
+
+#ifdef WIN32
+static SRWLOCK poolLock = SRWLOCK_INIT;
+#define _LockPool()     AcquireSRWLockExclusive(&poolLock)
+#define _UnlockPool()   ReleaseSRWLockExclusive(&poolLock)
+#else
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+#define _LockPool()     pthread_mutex_lock(&poolLock)
+#define _UnlockPool()   pthread_mutex_unlock(&poolLock)
+#endif
+
+int  _AttachPoolAlgorithm(graphP theGraph, int algorithm);
+int  _GetPoolClass(long long arcCapacity);
+
+/********************************************************************
+ gp_PoolAcquire()
+ Returns an initialized graph of order N with no edges, an arc capacity
+ of at least arcCapacity (or of the default capacity for N if arcCapacity
+ is 0), and the extension needed to gp_Embed() it with the embedFlags
+ given by algorithm attached.  The algorithm is one of EMBEDFLAGS_PLANAR,
+ OUTERPLANAR, DRAWPLANAR, SEARCHFORK23, SEARCHFORK33 or SEARCHFORK4.
+
+ The graph is reinitialized, not created, so it cannot be gp_Read();
+ add its edges with gp_AddEdge().  Return it with gp_PoolRelease().
+
+ Returns the graph, or NULL on invalid parameters or allocation failure
+ ********************************************************************/
+
+graphP gp_PoolAcquire(int N, int arcCapacity, int algorithm)
+{
+graphP theGraph = NULL, prev;
+long long classCapacity;
+int K;
+
+     if (N <= 0 || arcCapacity < 0 || (arcCapacity & 1))
+         return NULL;
+
+     if (algorithm != EMBEDFLAGS_PLANAR && algorithm != EMBEDFLAGS_OUTERPLANAR &&
+         algorithm != EMBEDFLAGS_DRAWPLANAR && algorithm != EMBEDFLAGS_SEARCHFORK23 &&
+         algorithm != EMBEDFLAGS_SEARCHFORK33 && algorithm != EMBEDFLAGS_SEARCHFORK4)
+         return NULL;
+
+     // Round the capacity up to its size class, unless that leaves the
+     // graph's index range, in which case the graph gets the capacity
+     // requested and is not taken from the pool (since the graphs of
+     // the class below may have less capacity)
+     classCapacity = arcCapacity > 0 ? arcCapacity : 2 * DEFAULT_EDGE_LIMIT * (long long) N;
+     if (gp_GetFirstEdge(theGraph) + classCapacity > GRAPHINDEX_MAX)
+         return NULL;
+
+     K = _GetPoolClass(classCapacity);
+     if (classCapacity > (1LL << K) && gp_GetFirstEdge(theGraph) + (1LL << (K+1)) <= GRAPHINDEX_MAX)
+         classCapacity = 1LL << ++K;
+
+     // Take an idle graph of the same order and algorithm from the class
+     if (classCapacity == (1LL << K))
+     {
+         _LockPool();
+         prev = NULL;
+         for (theGraph = poolClasses[K]; theGraph != NULL; theGraph = (graphP) theGraph->pool.next)
+         {
+             if (theGraph->N == N && theGraph->pool.algorithm == algorithm)
+             {
+                 if (prev == NULL)
+                     poolClasses[K] = (graphP) theGraph->pool.next;
+                 else
+                     prev->pool.next = theGraph->pool.next;
+                 poolClassSizes[K]--;
+                 break;
+             }
+             prev = theGraph;
+         }
+         _UnlockPool();
+
+         if (theGraph != NULL)
+         {
+             theGraph->pool.next = NULL;
+             return theGraph;
+         }
+     }
+
+     // Otherwise, create one.  The capacity is set and the extension is
+     // attached before initialization, so each array is allocated once
+     if ((theGraph = gp_New()) == NULL)
+         return NULL;
+
+     if (gp_EnsureArcCapacity(theGraph, (int) classCapacity) != OK ||
+         _AttachPoolAlgorithm(theGraph, algorithm) != OK ||
+         gp_InitGraph(theGraph, N) != OK)
+     {
+         gp_Free(&theGraph);
+         return NULL;
+     }
+
+     theGraph->pool.algorithm = algorithm;
+     return theGraph;
+}
+
+/********************************************************************
+ gp_PoolRelease()
+ Returns the graph indicated by pGraph to the pool and sets *pGraph to
+ NULL.  The graph is reinitialized, and its embed options, embed
+ statistics and phase observer are cleared, so the next acquirer gets
+ it as new.  The graph is freed instead if its size class is full,
+ if it was not made by gp_PoolAcquire() or if it was gp_Trim()'d.
+
+ The caller must not have attached or detached extensions or changed
+ the allocation flags of the graph.
+ ********************************************************************/
+
+void gp_PoolRelease(graphP *pGraph)
+{
+graphP theGraph;
+int K;
+
+     if (pGraph == NULL || *pGraph == NULL)
+         return;
+
+     theGraph = *pGraph;
+     *pGraph = NULL;
+
+     if (theGraph->pool.algorithm == 0 || gp_IsTrimmed(theGraph))
+     {
+         gp_Free(&theGraph);
+         return;
+     }
+
+     gp_ReinitializeGraph(theGraph);
+     gp_SetEmbedOptions(theGraph, 0);
+     gp_ClearEmbedStats(theGraph);
+     gp_SetEmbedPhaseObserver(theGraph, NULL, NULL);
+     gp_ClearTrace(theGraph);
+
+     K = _GetPoolClass(theGraph->arcCapacity);
+
+     _LockPool();
+     if (poolClassSizes[K] < GRAPHPOOL_CLASSLIMIT)
+     {
+         theGraph->pool.next = poolClasses[K];
+         poolClasses[K] = theGraph;
+         poolClassSizes[K]++;
+         theGraph = NULL;
+     }
+     _UnlockPool();
+
+     if (theGraph != NULL)
+         gp_Free(&theGraph);
+}
+
+/********************************************************************
+ gp_PoolClear()
+ Frees all idle graphs in the pool.  Graphs that are acquired at the
+ time remain valid and can still be released to the pool.
+ ********************************************************************/
+
+void gp_PoolClear(void)
+{
+graphP idleGraphs[GRAPHPOOL_NUMCLASSES], theGraph;
+int K;
+
+     _LockPool();
+     for (K = 0; K < GRAPHPOOL_NUMCLASSES; K++)
+     {
+         idleGraphs[K] = poolClasses[K];
+         poolClasses[K] = NULL;
+         poolClassSizes[K] = 0;
+     }
+     _UnlockPool();
+
+     for (K = 0; K < GRAPHPOOL_NUMCLASSES; K++)
+     {
+         while ((theGraph = idleGraphs[K]) != NULL)
+         {
+             idleGraphs[K] = (graphP) theGraph->pool.next;
+             gp_Free(&theGraph);
+         }
+     }
+}
+
+/********************************************************************
+ _AttachPoolAlgorithm()
+ Attaches the extension needed for the algorithm, if any, under the
+ pool lock.
+ ********************************************************************/
+
+int  _AttachPoolAlgorithm(graphP theGraph, int algorithm)
+{
+int RetVal = OK;
+
+     _LockPool();
+     switch (algorithm)
+     {
+         case EMBEDFLAGS_DRAWPLANAR   : RetVal = gp_AttachDrawPlanar(theGraph); break;
+         case EMBEDFLAGS_SEARCHFORK23 : RetVal = gp_AttachK23Search(theGraph); break;
+         case EMBEDFLAGS_SEARCHFORK33 : RetVal = gp_AttachK33Search(theGraph); break;
+         case EMBEDFLAGS_SEARCHFORK4  : RetVal = gp_AttachK4Search(theGraph); break;
+     }
+     _UnlockPool();
+
+     return RetVal;
+}
+
+/********************************************************************
+ _GetPoolClass()
+ Returns the size class of an arc capacity, i.e. floor(log2(arcCapacity)),
+ limited to the number of classes.
+ ********************************************************************/
+
+int  _GetPoolClass(long long arcCapacity)
+{
+int K = 0;
+
+     while (K < GRAPHPOOL_NUMCLASSES-1 && (arcCapacity >> (K+1)) > 0)
+         K++;
+
+     return K;
+}
@@ -30,6 +30,11 @@ extern "C" {
 // before calling gp_InitGraph() or gp_Read().
 #define DEFAULT_EDGE_LIMIT      3
 
+// The largest N for which gp_InitGraph() accepts the default edge capacity,
+// i.e. for which the indices of 2N vertices and of 6N arcs all fit in a graphIndex.
+// Whether the memory can be allocated depends on the machine.
+#define MAX_DEFAULT_N   ((GRAPHINDEX_MAX - 2) / (2*DEFAULT_EDGE_LIMIT))
+
 /********************************************************************
  Edge Record Definition
 
@@ -44,24 +49,46 @@ extern "C" {
     this edge record (an index into array V).
 
  flags: Bits 0-15 reserved for library; bits 16 and higher for apps
-        Bit 0: Visited
+        (none if NARROW_INDEX is defined)
+        Bit 0: Unused (see bits 8-15)
         Bit 1: DFS type has been set, versus not set
         Bit 2: DFS tree edge, versus cycle edge (co-tree edge, etc.)
         Bit 3: DFS arc to descendant, versus arc to ancestor
         Bit 4: Inverted (same as marking an edge with a "sign" of -1)
         Bit 5: Arc is directed into the containing vertex only
         Bit 6: Arc is directed from the containing vertex only
+        Bits 8-15: Visited stamp; the edge record is visited if the stamp
+                   equals the edgeVisitedStamp of the graph
  ********************************************************************/
 
 typedef struct
 {
-	int  link[2];
-	int  neighbor;
-	unsigned flags;
+	graphIndex link[2];
+	graphIndex neighbor;
+	graphFlags flags;
 } edgeRec;
 
 typedef edgeRec * edgeRecP;
 
+// If EDGE_SOA is defined, then the members of the edge records are stored
+// as a structure of arrays rather than an array of structures.  The graph's
+// array E is then one block of the same size, carved into a links column
+// (ELink, two indices per arc), a neighbor column (ENeighbor) and a flags
+// column (EFlags), so that loops that read only some members of the arcs,
+// such as the neighbor during the walkup, fetch fewer cache lines.  The
+// edgeRec structure is still used for sizing, and the accessors below
+// hide the difference.
+
+#ifdef EDGE_SOA
+#define gp_EdgeLink(theGraph, e, theLink) (theGraph->ELink[((e) << 1) + (theLink)])
+#define gp_EdgeNeighbor(theGraph, e) (theGraph->ENeighbor[e])
+#define gp_EdgeFlags(theGraph, e) (theGraph->EFlags[e])
+#else
+#define gp_EdgeLink(theGraph, e, theLink) (theGraph->E[e].link[theLink])
+#define gp_EdgeNeighbor(theGraph, e) (theGraph->E[e].neighbor)
+#define gp_EdgeFlags(theGraph, e) (theGraph->E[e].flags)
+#endif
+
 #if NIL == 0
 #define gp_IsArc(e) (e)
 #define gp_IsNotArc(e) (!(e))
@@ -77,33 +104,50 @@ typedef edgeRec * edgeRecP;
 #define gp_EdgeInUse(theGraph, e) (gp_IsVertex(gp_GetNeighbor(theGraph, e)))
 #define gp_EdgeNotInUse(theGraph, e) (gp_IsNotVertex(gp_GetNeighbor(theGraph, e)))
 #define gp_EdgeIndexBound(theGraph) (gp_GetFirstEdge(theGraph) + (theGraph)->arcCapacity)
+// Visited flags are stored as a stamp in bits 8-15 of the flags of vertex and
+// edge records.  A record is visited if its stamp equals the graph's current
+// stamp, so all records are cleared at once by advancing the graph's stamp.
+// The stamp zero is never current, so zeroed records are unvisited.
+#define VISITED_STAMP_MASK		0xFF00
+#define VISITED_STAMP_INCREMENT	0x0100
+
 #define gp_EdgeInUseIndexBound(theGraph) (gp_GetFirstEdge(theGraph) + (((theGraph)->M + sp_GetCurrentSize((theGraph)->edgeHoles)) << 1))
 
+// The edge records at and above the edgeHighWater mark of a graph are in their
+// initial state, so reinitialization and copying need not go beyond it
+#define gp_EdgeTouchedIndexBound(theGraph) ((theGraph)->edgeHighWater)
+#define gp_UpdateEdgeHighWater(theGraph) \
+{ \
+	if ((theGraph)->edgeHighWater < gp_EdgeInUseIndexBound(theGraph)) \
+		(theGraph)->edgeHighWater = gp_EdgeInUseIndexBound(theGraph); \
+}
+
 // An edge is represented by two consecutive edge records (arcs) in the edge array E.
 // If an even number, xor 1 will add one; if an odd number, xor 1 will subtract 1
 #define gp_GetTwinArc(theGraph, Arc) ((Arc) ^ 1)
 
 // Access to adjacency list pointers
-#define gp_GetNextArc(theGraph, e) (theGraph->E[e].link[0])
-#define gp_GetPrevArc(theGraph, e) (theGraph->E[e].link[1])
-#define gp_GetAdjacentArc(theGraph, e, theLink) (theGraph->E[e].link[theLink])
+#define gp_GetNextArc(theGraph, e) (gp_EdgeLink(theGraph, e, 0))
+#define gp_GetPrevArc(theGraph, e) (gp_EdgeLink(theGraph, e, 1))
+#define gp_GetAdjacentArc(theGraph, e, theLink) (gp_EdgeLink(theGraph, e, theLink))
 
-#define gp_SetNextArc(theGraph, e, newNextArc) (theGraph->E[e].link[0] = newNextArc)
-#define gp_SetPrevArc(theGraph, e, newPrevArc) (theGraph->E[e].link[1] = newPrevArc)
-#define gp_SetAdjacentArc(theGraph, e, theLink, newArc) (theGraph->E[e].link[theLink] = newArc)
+#define gp_SetNextArc(theGraph, e, newNextArc) (gp_EdgeLink(theGraph, e, 0) = newNextArc)
+#define gp_SetPrevArc(theGraph, e, newPrevArc) (gp_EdgeLink(theGraph, e, 1) = newPrevArc)
+#define gp_SetAdjacentArc(theGraph, e, theLink, newArc) (gp_EdgeLink(theGraph, e, theLink) = newArc)
 
 // Access to vertex 'neighbor' member indicated by arc
-#define gp_GetNeighbor(theGraph, e) (theGraph->E[e].neighbor)
-#define gp_SetNeighbor(theGraph, e, v) (theGraph->E[e].neighbor = v)
+#define gp_GetNeighbor(theGraph, e) (gp_EdgeNeighbor(theGraph, e))
+#define gp_SetNeighbor(theGraph, e, v) (gp_EdgeNeighbor(theGraph, e) = v)
 
 // Initializer for edge flags
-#define gp_InitEdgeFlags(theGraph, e) (theGraph->E[e].flags = 0)
+#define gp_InitEdgeFlags(theGraph, e) (gp_EdgeFlags(theGraph, e) = 0)
 
 // Definitions of and access to edge flags
-#define EDGE_VISITED_MASK		1
-#define gp_GetEdgeVisited(theGraph, e) (theGraph->E[e].flags&EDGE_VISITED_MASK)
-#define gp_ClearEdgeVisited(theGraph, e) (theGraph->E[e].flags &= ~EDGE_VISITED_MASK)
-#define gp_SetEdgeVisited(theGraph, e) (theGraph->E[e].flags |= EDGE_VISITED_MASK)
+#define EDGE_VISITED_MASK		VISITED_STAMP_MASK
+#define gp_GetEdgeVisited(theGraph, e) ((gp_EdgeFlags(theGraph, e)&EDGE_VISITED_MASK) == theGraph->edgeVisitedStamp)
+#define gp_ClearEdgeVisited(theGraph, e) (gp_EdgeFlags(theGraph, e) &= ~EDGE_VISITED_MASK)
+#define gp_SetEdgeVisited(theGraph, e) \
+	(gp_EdgeFlags(theGraph, e) = (gp_EdgeFlags(theGraph, e) & ~EDGE_VISITED_MASK) | theGraph->edgeVisitedStamp)
 
 // The edge type is defined by bits 1-3, 2+4+8=14
 #define EDGE_TYPE_MASK		14
@@ -123,24 +167,24 @@ typedef edgeRec * edgeRecP;
 #define EDGE_TYPE_NOTDEFINED	0
 #define EDGE_TYPE_RANDOMTREE	4
 
-#define gp_GetEdgeType(theGraph, e) (theGraph->E[e].flags&EDGE_TYPE_MASK)
-#define gp_ClearEdgeType(theGraph, e) (theGraph->E[e].flags &= ~EDGE_TYPE_MASK)
-#define gp_SetEdgeType(theGraph, e, type) (theGraph->E[e].flags |= type)
+#define gp_GetEdgeType(theGraph, e) (gp_EdgeFlags(theGraph, e)&EDGE_TYPE_MASK)
+#define gp_ClearEdgeType(theGraph, e) (gp_EdgeFlags(theGraph, e) &= ~EDGE_TYPE_MASK)
+#define gp_SetEdgeType(theGraph, e, type) (gp_EdgeFlags(theGraph, e) |= type)
 #define gp_ResetEdgeType(theGraph, e, type) \
-	(theGraph->E[e].flags = (theGraph->E[e].flags & ~EDGE_TYPE_MASK) | type)
+	(gp_EdgeFlags(theGraph, e) = (gp_EdgeFlags(theGraph, e) & ~EDGE_TYPE_MASK) | type)
 
 #define EDGEFLAG_INVERTED_MASK 16
-#define gp_GetEdgeFlagInverted(theGraph, e) (theGraph->E[e].flags & EDGEFLAG_INVERTED_MASK)
-#define gp_SetEdgeFlagInverted(theGraph, e) (theGraph->E[e].flags |= EDGEFLAG_INVERTED_MASK)
-#define gp_ClearEdgeFlagInverted(theGraph, e) (theGraph->E[e].flags &= (~EDGEFLAG_INVERTED_MASK))
-#define gp_XorEdgeFlagInverted(theGraph, e) (theGraph->E[e].flags ^= EDGEFLAG_INVERTED_MASK)
+#define gp_GetEdgeFlagInverted(theGraph, e) (gp_EdgeFlags(theGraph, e) & EDGEFLAG_INVERTED_MASK)
+#define gp_SetEdgeFlagInverted(theGraph, e) (gp_EdgeFlags(theGraph, e) |= EDGEFLAG_INVERTED_MASK)
+#define gp_ClearEdgeFlagInverted(theGraph, e) (gp_EdgeFlags(theGraph, e) &= (~EDGEFLAG_INVERTED_MASK))
+#define gp_XorEdgeFlagInverted(theGraph, e) (gp_EdgeFlags(theGraph, e) ^= EDGEFLAG_INVERTED_MASK)
 
 #define EDGEFLAG_DIRECTION_INONLY	32
 #define EDGEFLAG_DIRECTION_OUTONLY	64
 #define EDGEFLAG_DIRECTION_MASK		96
 
 // Returns the direction, if any, of the edge record
-#define gp_GetDirection(theGraph, e) (theGraph->E[e].flags & EDGEFLAG_DIRECTION_MASK)
+#define gp_GetDirection(theGraph, e) (gp_EdgeFlags(theGraph, e) & EDGEFLAG_DIRECTION_MASK)
 
 //A direction of 0 clears directedness. Otherwise, edge record e is set
 //to edgeFlag_Direction and e's twin arc is set to the opposing setting.
@@ -148,22 +192,32 @@ typedef edgeRec * edgeRecP;
 { \
 	if (edgeFlag_Direction == EDGEFLAG_DIRECTION_INONLY) \
 	{ \
-		theGraph->E[e].flags |= EDGEFLAG_DIRECTION_INONLY; \
-		theGraph->E[gp_GetTwinArc(theGraph, e)].flags |= EDGEFLAG_DIRECTION_OUTONLY; \
+		gp_EdgeFlags(theGraph, e) |= EDGEFLAG_DIRECTION_INONLY; \
+		gp_EdgeFlags(theGraph, gp_GetTwinArc(theGraph, e)) |= EDGEFLAG_DIRECTION_OUTONLY; \
 	} \
 	else if (edgeFlag_Direction == EDGEFLAG_DIRECTION_OUTONLY) \
 	{ \
-		theGraph->E[e].flags |= EDGEFLAG_DIRECTION_OUTONLY; \
-		theGraph->E[gp_GetTwinArc(theGraph, e)].flags |= EDGEFLAG_DIRECTION_INONLY; \
+		gp_EdgeFlags(theGraph, e) |= EDGEFLAG_DIRECTION_OUTONLY; \
+		gp_EdgeFlags(theGraph, gp_GetTwinArc(theGraph, e)) |= EDGEFLAG_DIRECTION_INONLY; \
 	} \
 	else \
 	{ \
-		theGraph->E[e].flags &= ~(EDGEFLAG_DIRECTION_INONLY|EDGEFLAG_DIRECTION_OUTONLY); \
-		theGraph->E[gp_GetTwinArc(theGraph, e)].flags &= ~EDGEFLAG_DIRECTION_MASK; \
+		gp_EdgeFlags(theGraph, e) &= ~(EDGEFLAG_DIRECTION_INONLY|EDGEFLAG_DIRECTION_OUTONLY); \
+		gp_EdgeFlags(theGraph, gp_GetTwinArc(theGraph, e)) &= ~EDGEFLAG_DIRECTION_MASK; \
 	} \
 }
 
+#ifdef EDGE_SOA
+#define gp_CopyEdgeRec(dstGraph, edst, srcGraph, esrc) \
+	{ \
+		gp_EdgeLink(dstGraph, edst, 0) = gp_EdgeLink(srcGraph, esrc, 0); \
+		gp_EdgeLink(dstGraph, edst, 1) = gp_EdgeLink(srcGraph, esrc, 1); \
+		gp_EdgeNeighbor(dstGraph, edst) = gp_EdgeNeighbor(srcGraph, esrc); \
+		gp_EdgeFlags(dstGraph, edst) = gp_EdgeFlags(srcGraph, esrc); \
+	}
+#else
 #define gp_CopyEdgeRec(dstGraph, edst, srcGraph, esrc) (dstGraph->E[edst] = srcGraph->E[esrc])
+#endif
 
 /********************************************************************
  Vertex Record Definition
@@ -179,7 +233,8 @@ typedef edgeRec * edgeRecP;
  components).
 
  link[2]: the first and last edge records (arcs) in the adjacency list
-          of the vertex.
+          of the vertex.  Kept in the hot vertex record if VERTEX_HOTREC
+          is defined.
 
  index: In vertices, stores either the depth first index of a vertex or
         the original array index of the vertex if the vertices of the
@@ -192,30 +247,51 @@ typedef edgeRec * edgeRecP;
         DFS children of the vertex).
 
  flags: Bits 0-15 reserved for library; bits 16 and higher for apps
-        Bit 0: visited, for vertices and virtual vertices
-				Use in lieu of TYPE_VERTEX_VISITED in K4 algorithm
+        (none if NARROW_INDEX is defined)
+        Bit 0: Unused (see bits 8-15)
 		Bit 1: Obstruction type VERTEX_TYPE_SET (versus not set, i.e. VERTEX_TYPE_UNKNOWN)
 		Bit 2: Obstruction type qualifier RYW (set) versus RXW (clear)
 		Bit 3: Obstruction type qualifier high (set) versus low (clear)
+		Bits 8-15: Visited stamp, for vertices and virtual vertices; the
+				vertex is visited if the stamp equals the vertexVisitedStamp
+				of the graph.  Use in lieu of TYPE_VERTEX_VISITED in K4 algorithm
  ********************************************************************/
 
 typedef struct
 {
-	int  link[2];
-	int  index;
-	unsigned flags;
+#ifndef VERTEX_HOTREC
+	graphIndex link[2];
+#endif
+	graphIndex index;
+	graphFlags flags;
 } vertexRec;
 
 typedef vertexRec * vertexRecP;
 
+// If VERTEX_HOTREC is defined, the links of the vertex records, the external
+// face links and the vertexInfo members used by each Walkup and Walkdown step
+// are kept together in the hot vertex records of array H (see vertexHotRec).
+// The accessors below locate them, so the member accessors are the same
+// in either layout.
+
+#ifdef VERTEX_HOTREC
+#define gp_VertexLinks(theGraph, v) (theGraph->H[v].link)
+#define gp_ExtFaceLinks(theGraph, v) (theGraph->H[v].extFaceVertex)
+#define gp_VertexHotInfo(theGraph, v) (theGraph->H[v])
+#else
+#define gp_VertexLinks(theGraph, v) (theGraph->V[v].link)
+#define gp_ExtFaceLinks(theGraph, v) (theGraph->extFace[v].vertex)
+#define gp_VertexHotInfo(theGraph, v) (theGraph->VI[v])
+#endif
+
 // Accessors for vertex adjacency list links
-#define gp_GetFirstArc(theGraph, v) (theGraph->V[v].link[0])
-#define gp_GetLastArc(theGraph, v) (theGraph->V[v].link[1])
-#define gp_GetArc(theGraph, v, theLink) (theGraph->V[v].link[theLink])
+#define gp_GetFirstArc(theGraph, v) (gp_VertexLinks(theGraph, v)[0])
+#define gp_GetLastArc(theGraph, v) (gp_VertexLinks(theGraph, v)[1])
+#define gp_GetArc(theGraph, v, theLink) (gp_VertexLinks(theGraph, v)[theLink])
 
-#define gp_SetFirstArc(theGraph, v, newFirstArc) (theGraph->V[v].link[0] = newFirstArc)
-#define gp_SetLastArc(theGraph, v, newLastArc) (theGraph->V[v].link[1] = newLastArc)
-#define gp_SetArc(theGraph, v, theLink, newArc) (theGraph->V[v].link[theLink] = newArc)
+#define gp_SetFirstArc(theGraph, v, newFirstArc) (gp_VertexLinks(theGraph, v)[0] = newFirstArc)
+#define gp_SetLastArc(theGraph, v, newLastArc) (gp_VertexLinks(theGraph, v)[1] = newLastArc)
+#define gp_SetArc(theGraph, v, theLink, newArc) (gp_VertexLinks(theGraph, v)[theLink] = newArc)
 
 // Vertex conversions and iteration
 #if NIL == 0
@@ -280,10 +356,11 @@ typedef vertexRec * vertexRecP;
 #define gp_InitVertexFlags(theGraph, v) (theGraph->V[v].flags = 0)
 
 // Definitions and accessors for vertex flags
-#define VERTEX_VISITED_MASK		1
-#define gp_GetVertexVisited(theGraph, v) (theGraph->V[v].flags&VERTEX_VISITED_MASK)
+#define VERTEX_VISITED_MASK		VISITED_STAMP_MASK
+#define gp_GetVertexVisited(theGraph, v) ((theGraph->V[v].flags&VERTEX_VISITED_MASK) == theGraph->vertexVisitedStamp)
 #define gp_ClearVertexVisited(theGraph, v) (theGraph->V[v].flags &= ~VERTEX_VISITED_MASK)
-#define gp_SetVertexVisited(theGraph, v) (theGraph->V[v].flags |= VERTEX_VISITED_MASK)
+#define gp_SetVertexVisited(theGraph, v) \
+	(theGraph->V[v].flags = (theGraph->V[v].flags & ~VERTEX_VISITED_MASK) | theGraph->vertexVisitedStamp)
 
 // The obstruction type is defined by bits 1-3, 2+4+8=14
 // Bit 1 - 2 if type set, 0 if not
@@ -312,6 +389,26 @@ typedef vertexRec * vertexRecP;
 #define gp_ResetVertexObstructionType(theGraph, v, type) \
 	(theGraph->V[v].flags = (theGraph->V[v].flags & ~VERTEX_OBSTRUCTIONTYPE_MASK) | type)
 
+#ifdef VERTEX_HOTREC
+#define gp_CopyVertexRec(dstGraph, vdst, srcGraph, vsrc) \
+	{ \
+		dstGraph->V[vdst] = srcGraph->V[vsrc]; \
+		dstGraph->H[vdst].link[0] = srcGraph->H[vsrc].link[0]; \
+		dstGraph->H[vdst].link[1] = srcGraph->H[vsrc].link[1]; \
+	}
+
+#define gp_SwapVertexRec(dstGraph, vdst, srcGraph, vsrc) \
+	{ \
+		vertexRec tempV = dstGraph->V[vdst]; \
+		vertexHotRec tempH = dstGraph->H[vdst]; \
+		dstGraph->V[vdst] = srcGraph->V[vsrc]; \
+		dstGraph->H[vdst].link[0] = srcGraph->H[vsrc].link[0]; \
+		dstGraph->H[vdst].link[1] = srcGraph->H[vsrc].link[1]; \
+		srcGraph->V[vsrc] = tempV; \
+		srcGraph->H[vsrc].link[0] = tempH.link[0]; \
+		srcGraph->H[vsrc].link[1] = tempH.link[1]; \
+	}
+#else
 #define gp_CopyVertexRec(dstGraph, vdst, srcGraph, vsrc) (dstGraph->V[vdst] = srcGraph->V[vsrc])
 
 #define gp_SwapVertexRec(dstGraph, vdst, srcGraph, vsrc) \
@@ -320,6 +417,7 @@ typedef vertexRec * vertexRecP;
 		dstGraph->V[vdst] = srcGraph->V[vsrc]; \
 		srcGraph->V[vsrc] = tempV; \
 	}
+#endif
 
 /********************************************************************
  This structure defines a pair of links used by each vertex and virtual vertex
@@ -336,13 +434,13 @@ typedef vertexRec * vertexRecP;
 
 typedef struct
 {
-    int vertex[2];
+    graphIndex vertex[2];
 } extFaceLinkRec;
 
 typedef extFaceLinkRec * extFaceLinkRecP;
 
-#define gp_GetExtFaceVertex(theGraph, v, link) (theGraph->extFace[v].vertex[link])
-#define gp_SetExtFaceVertex(theGraph, v, link, theVertex) (theGraph->extFace[v].vertex[link] = theVertex)
+#define gp_GetExtFaceVertex(theGraph, v, link) (gp_ExtFaceLinks(theGraph, v)[link])
+#define gp_SetExtFaceVertex(theGraph, v, link, theVertex) (gp_ExtFaceLinks(theGraph, v)[link] = theVertex)
 
 /********************************************************************
  Vertex Info Structure Definition.
@@ -393,21 +491,61 @@ typedef extFaceLinkRec * extFaceLinkRecP;
 
 typedef struct
 {
-	int parent, leastAncestor, lowpoint;
-
+#ifndef VERTEX_HOTREC
     int visitedInfo;
+#endif
+
+	graphIndex parent, leastAncestor;
 
-    int pertinentEdge,
-		pertinentRoots,
-		futurePertinentChild,
+#ifndef VERTEX_HOTREC
+	graphIndex lowpoint;
+
+    graphIndex pertinentEdge,
+		pertinentRoots;
+#endif
+
+    graphIndex futurePertinentChild,
 		sortedDFSChildList,
 		fwdArcList;
 } vertexInfo;
 
 typedef vertexInfo * vertexInfoP;
 
-#define gp_GetVertexVisitedInfo(theGraph, v) (theGraph->VI[v].visitedInfo)
-#define gp_SetVertexVisitedInfo(theGraph, v, theVisitedInfo) (theGraph->VI[v].visitedInfo = theVisitedInfo)
+/********************************************************************
+ Hot Vertex Record Definition
+
+ If VERTEX_HOTREC is defined, the members of vertexRec, extFaceLinkRec
+ and vertexInfo that are read on each step of the Walkup and Walkdown
+ are kept in this record rather than in arrays V, extFace and VI, so
+ that a step costs one cache miss rather than three.  The record is
+ 32 bytes and array H is aligned to 64 bytes, so no record straddles
+ a cache line.  Array H has a record for each vertex and virtual
+ vertex, but the vertexInfo members are only used by primary vertices.
+
+	link[2]: the link[2] of the vertexRec
+	extFaceVertex[2]: the vertex[2] of the extFaceLinkRec
+	visitedInfo, lowpoint, pertinentEdge, pertinentRoots: the members
+				of the vertexInfo
+ ********************************************************************/
+
+#ifdef VERTEX_HOTREC
+
+typedef struct
+{
+	int link[2];
+	int extFaceVertex[2];
+	int visitedInfo, lowpoint;
+	int pertinentEdge, pertinentRoots;
+} vertexHotRec;
+
+typedef vertexHotRec * vertexHotRecP;
+
+#define VERTEX_HOTREC_ALIGNMENT 64
+
+#endif
+
+#define gp_GetVertexVisitedInfo(theGraph, v) (gp_VertexHotInfo(theGraph, v).visitedInfo)
+#define gp_SetVertexVisitedInfo(theGraph, v, theVisitedInfo) (gp_VertexHotInfo(theGraph, v).visitedInfo = theVisitedInfo)
 
 #define gp_GetVertexParent(theGraph, v) (theGraph->VI[v].parent)
 #define gp_SetVertexParent(theGraph, v, theParent) (theGraph->VI[v].parent = theParent)
@@ -415,19 +553,19 @@ typedef vertexInfo * vertexInfoP;
 #define gp_GetVertexLeastAncestor(theGraph, v) (theGraph->VI[v].leastAncestor)
 #define gp_SetVertexLeastAncestor(theGraph, v, theLeastAncestor) (theGraph->VI[v].leastAncestor = theLeastAncestor)
 
-#define gp_GetVertexLowpoint(theGraph, v) (theGraph->VI[v].lowpoint)
-#define gp_SetVertexLowpoint(theGraph, v, theLowpoint) (theGraph->VI[v].lowpoint = theLowpoint)
+#define gp_GetVertexLowpoint(theGraph, v) (gp_VertexHotInfo(theGraph, v).lowpoint)
+#define gp_SetVertexLowpoint(theGraph, v, theLowpoint) (gp_VertexHotInfo(theGraph, v).lowpoint = theLowpoint)
 
-#define gp_GetVertexPertinentEdge(theGraph, v) (theGraph->VI[v].pertinentEdge)
-#define gp_SetVertexPertinentEdge(theGraph, v, e) (theGraph->VI[v].pertinentEdge = e)
+#define gp_GetVertexPertinentEdge(theGraph, v) (gp_VertexHotInfo(theGraph, v).pertinentEdge)
+#define gp_SetVertexPertinentEdge(theGraph, v, e) (gp_VertexHotInfo(theGraph, v).pertinentEdge = e)
 
-#define gp_GetVertexPertinentRootsList(theGraph, v) (theGraph->VI[v].pertinentRoots)
-#define gp_SetVertexPertinentRootsList(theGraph, v, pertinentRootsHead) (theGraph->VI[v].pertinentRoots = pertinentRootsHead)
+#define gp_GetVertexPertinentRootsList(theGraph, v) (gp_VertexHotInfo(theGraph, v).pertinentRoots)
+#define gp_SetVertexPertinentRootsList(theGraph, v, pertinentRootsHead) (gp_VertexHotInfo(theGraph, v).pertinentRoots = pertinentRootsHead)
 
-#define gp_GetVertexFirstPertinentRoot(theGraph, v) gp_GetRootFromDFSChild(theGraph, theGraph->VI[v].pertinentRoots)
-#define gp_GetVertexFirstPertinentRootChild(theGraph, v) (theGraph->VI[v].pertinentRoots)
-#define gp_GetVertexLastPertinentRoot(theGraph, v)  gp_GetRootFromDFSChild(theGraph, LCGetPrev(theGraph->BicompRootLists, theGraph->VI[v].pertinentRoots, NIL))
-#define gp_GetVertexLastPertinentRootChild(theGraph, v)  LCGetPrev(theGraph->BicompRootLists, theGraph->VI[v].pertinentRoots, NIL)
+#define gp_GetVertexFirstPertinentRoot(theGraph, v) gp_GetRootFromDFSChild(theGraph, gp_VertexHotInfo(theGraph, v).pertinentRoots)
+#define gp_GetVertexFirstPertinentRootChild(theGraph, v) (gp_VertexHotInfo(theGraph, v).pertinentRoots)
+#define gp_GetVertexLastPertinentRoot(theGraph, v)  gp_GetRootFromDFSChild(theGraph, LCGetPrev(theGraph->BicompRootLists, gp_VertexHotInfo(theGraph, v).pertinentRoots, NIL))
+#define gp_GetVertexLastPertinentRootChild(theGraph, v)  LCGetPrev(theGraph->BicompRootLists, gp_VertexHotInfo(theGraph, v).pertinentRoots, NIL)
 
 #define gp_DeleteVertexPertinentRoot(theGraph, v, R) \
 			gp_SetVertexPertinentRootsList(theGraph, v, \
@@ -456,6 +594,7 @@ typedef vertexInfo * vertexInfoP;
         { \
 			theGraph->VI[w].futurePertinentChild = \
 					gp_GetVertexNextDFSChild(theGraph, w, gp_GetVertexFuturePertinentChild(theGraph, w)); \
+			gp_IncrementCounter(theGraph, futurePertinentChildAdvances); \
         } \
         else break; \
 	}
@@ -471,6 +610,31 @@ typedef vertexInfo * vertexInfoP;
 #define gp_GetVertexFwdArcList(theGraph, v) (theGraph->VI[v].fwdArcList)
 #define gp_SetVertexFwdArcList(theGraph, v, theFwdArcList) (theGraph->VI[v].fwdArcList = theFwdArcList)
 
+#ifdef VERTEX_HOTREC
+#define _gp_CopyVertexHotInfo(dstHotRec, srcHotRec) \
+	{ \
+		(dstHotRec).visitedInfo = (srcHotRec).visitedInfo; \
+		(dstHotRec).lowpoint = (srcHotRec).lowpoint; \
+		(dstHotRec).pertinentEdge = (srcHotRec).pertinentEdge; \
+		(dstHotRec).pertinentRoots = (srcHotRec).pertinentRoots; \
+	}
+
+#define gp_CopyVertexInfo(dstGraph, dstI, srcGraph, srcI) \
+	{ \
+		dstGraph->VI[dstI] = srcGraph->VI[srcI]; \
+		_gp_CopyVertexHotInfo(dstGraph->H[dstI], srcGraph->H[srcI]); \
+	}
+
+#define gp_SwapVertexInfo(dstGraph, dstPos, srcGraph, srcPos) \
+	{ \
+		vertexInfo tempVI = dstGraph->VI[dstPos]; \
+		vertexHotRec tempH = dstGraph->H[dstPos]; \
+		dstGraph->VI[dstPos] = srcGraph->VI[srcPos]; \
+		_gp_CopyVertexHotInfo(dstGraph->H[dstPos], srcGraph->H[srcPos]); \
+		srcGraph->VI[srcPos] = tempVI; \
+		_gp_CopyVertexHotInfo(srcGraph->H[srcPos], tempH); \
+	}
+#else
 #define gp_CopyVertexInfo(dstGraph, dstI, srcGraph, srcI) (dstGraph->VI[dstI] = srcGraph->VI[srcI])
 
 #define gp_SwapVertexInfo(dstGraph, dstPos, srcGraph, srcPos) \
@@ -479,6 +643,7 @@ typedef vertexInfo * vertexInfoP;
 		dstGraph->VI[dstPos] = srcGraph->VI[srcPos]; \
 		srcGraph->VI[srcPos] = tempVI; \
 	}
+#endif
 
 /********************************************************************
  Variables needed in embedding by Kuratowski subgraph isolator:
@@ -522,6 +687,247 @@ typedef isolatorContext * isolatorContextP;
 #define MINORTYPE_E6        1024
 #define MINORTYPE_E7        2048
 
+/********************************************************************
+ Hot path event counters of the edge addition embedder, maintained
+ only if EMBEDCOUNTERS is defined (see appconst.h).
+        walkUpHops: steps of the Walkup along the external faces of bicomps
+        walkDownIterations: vertices visited by the Walkdown traversals
+        mergeBicompsCalls: calls by the Walkdown to fpMergeBicomps()
+        invertVertexFlips: vertex orientation flips by _InvertVertex()
+        inactiveVertexHops: inactive vertices skipped via fpHandleInactiveVertex()
+        futurePertinentChildAdvances: DFS children skipped over by
+                gp_UpdateVertexFuturePertinentChild()
+        blockedBicompReentries: Walkdown resumptions after an extension
+                cleared a blockage in fpHandleBlockedBicomp() (e.g. K_4, K_{3,3})
+*/
+
+typedef struct
+{
+    unsigned long long walkUpHops, walkDownIterations;
+    unsigned long long mergeBicompsCalls, invertVertexFlips;
+    unsigned long long inactiveVertexHops, futurePertinentChildAdvances;
+    unsigned long long blockedBicompReentries;
+} embedCounters;
+
+#ifdef EMBEDCOUNTERS
+#define gp_IncrementCounter(theGraph, counter) (theGraph->stats.counters.counter++)
+#else
+#define gp_IncrementCounter(theGraph, counter) ((void) 0)
+#endif
+
+/********************************************************************
+ Embedding statistics accumulated by gp_Embed() over the lifetime of
+ a graph (see gp_GetEmbedStats() and gp_ClearEmbedStats()).
+ All times are in nanoseconds of a monotonic clock.
+        numEmbeds: the number of calls to gp_Embed()
+        initializeTime: DFS and the rest of fpEmbeddingInitialize()
+        edgeAdditionTime: the Walkup/Walkdown loop over the vertices,
+                excluding the obstruction isolation time
+        isolationTime: the fpHandleBlockedBicomp() calls that isolated
+                an embedding obstruction (Kuratowski subgraph, etc.)
+        postprocessTime: _OrientVerticesInEmbedding() and _JoinBicomps()
+        extensionPostprocessTime: the rest of fpEmbedPostprocess(), i.e.
+                the work done by extension algorithm overloads
+        totalTime: all of gp_Embed()
+        counters: the hot path event counters (zero unless EMBEDCOUNTERS)
+*/
+
+typedef struct
+{
+    unsigned long numEmbeds;
+    unsigned long long initializeTime, edgeAdditionTime, isolationTime;
+    unsigned long long postprocessTime, extensionPostprocessTime;
+    unsigned long long totalTime;
+    embedCounters counters;
+} embedStats;
+
+typedef embedStats * embedStatsP;
+
+/********************************************************************
+ Memory allocated for a graph, in bytes by component, as reported by
+ gp_GetMemoryUsage().
+        graph: the graph structure itself and its extension list records
+        vertexRecs: V, the primary and virtual vertex records, and H if
+                    VERTEX_HOTREC is defined
+        vertexInfos: VI, the additional information of the primary vertices
+        edgeRecs: E, the edge records allocated for the arc capacity
+        extFace: the external face short circuit records
+        listCollections: BicompRootLists and sortedDFSChildLists
+        stacks: theStack and edgeHoles
+        extensions: the blocks of extension columns (see gp_AddExtensionColumn())
+                and the contexts of the attached extensions, as reported by
+                the getMemoryUsage functions given to gp_AddExtension()
+        trace: the trace event ring buffer, if enabled by gp_EnableTrace()
+        total: the sum of the components
+*/
+
+typedef struct
+{
+    size_t graph;
+    size_t vertexRecs, vertexInfos, edgeRecs, extFace;
+    size_t listCollections, stacks;
+    size_t extensions;
+    size_t trace;
+    size_t total;
+} graphMemoryUsage;
+
+typedef graphMemoryUsage * graphMemoryUsageP;
+
+/********************************************************************
+ Phases of gp_Embed() reported to an embed phase observer, which a
+ client can set with gp_SetEmbedPhaseObserver() to measure each phase
+ with its own instruments (e.g. hardware performance counters).
+
+ The observer is called at each phase boundary with the phase to which
+ the work done since its previous call belongs.  The first call made
+ by each gp_Embed() reports EMBEDPHASE_NONE, so the observer can take
+ its starting readings.  The phases are as described for embedStats.
+*/
+
+#define EMBEDPHASE_NONE                     -1
+#define EMBEDPHASE_INITIALIZE               0
+#define EMBEDPHASE_EDGEADDITION             1
+#define EMBEDPHASE_ISOLATION                2
+#define EMBEDPHASE_POSTPROCESS              3
+#define EMBEDPHASE_EXTENSIONPOSTPROCESS     4
+#define NUMEMBEDPHASES                      5
+
+typedef void (*embedPhaseObserver)(void *context, int phase);
+
+#define gp_NotifyEmbedPhase(theGraph, phase) \
+        (theGraph->fpPhaseObserver != NULL ? \
+         theGraph->fpPhaseObserver(theGraph->phaseObserverContext, phase) : (void) 0)
+
+/********************************************************************
+ Trace events of the embedder, recorded only if EMBEDTRACE is defined
+ (see appconst.h) and a trace buffer has been enabled for the graph
+ with gp_EnableTrace().  Each event has a type and up to four
+ integer arguments, as follows:
+        EMBEDSTART: N, embedFlags
+        VERTEXSTEP: v, the vertex whose back edges are being embedded
+        WALKDOWNDESCENT: v, W, R, the descent of the Walkdown from the
+                cut vertex W into its pertinent child bicomp rooted by R
+        EMBEDBACKEDGE: v, R, Rout, W, the back edge embedded from the
+                root R of v to the descendant W, leaving R along Rout
+        MERGEVERTEX: W, W_in, R, R_out, a merge of R into W
+        INVERTVERTEX: W, the vertex whose orientation was flipped
+        MINORCHOSEN: v, R, W, minorType, the obstruction minor chosen
+                for isolation (see the MINORTYPE flags of isolatorContext)
+        EMBEDEND: the result of gp_Embed()
+*/
+
+#define TRACEEVENT_EMBEDSTART       1
+#define TRACEEVENT_VERTEXSTEP       2
+#define TRACEEVENT_WALKDOWNDESCENT  3
+#define TRACEEVENT_EMBEDBACKEDGE    4
+#define TRACEEVENT_MERGEVERTEX      5
+#define TRACEEVENT_INVERTVERTEX     6
+#define TRACEEVENT_MINORCHOSEN      7
+#define TRACEEVENT_EMBEDEND         8
+#define NUMTRACEEVENTTYPES          9
+
+typedef struct
+{
+    int type;
+    int arg[4];
+} traceEvent;
+
+typedef traceEvent * traceEventP;
+
+/********************************************************************
+ The trace buffer of a graph is a ring of a power of two number of
+ events that keeps the most recent ones.
+        events: the ring, or NULL if tracing is not enabled
+        mask: the ring capacity minus one
+        numEvents: the number of events recorded since the buffer was
+                enabled or cleared, of which the last MIN(numEvents,
+                capacity) are in the ring, the last at index
+                (numEvents - 1) & mask
+ The buffer belongs to its graph and is only written by the thread
+ that embeds the graph, so recording an event takes no lock and does
+ no I/O; graphs embedded by different threads are traced independently.
+ Recording is a few stores, so large graphs can be traced in production;
+ a ring that fits in the cache (e.g. 65536 events) keeps the overhead
+ to a few percent, whereas a ring of millions of events costs more.
+*/
+
+typedef struct
+{
+    traceEventP events;
+    unsigned int mask;
+    unsigned long long numEvents;
+} traceBuffer;
+
+#ifdef EMBEDTRACE
+#define gp_TraceEvent(theGraph, eventType, a, b, c, d) \
+        do { \
+            if (theGraph->trace.events != NULL) \
+            { \
+                traceEventP traceEvent_ = theGraph->trace.events + \
+                        (theGraph->trace.numEvents++ & theGraph->trace.mask); \
+                traceEvent_->type = eventType; \
+                traceEvent_->arg[0] = a; \
+                traceEvent_->arg[1] = b; \
+                traceEvent_->arg[2] = c; \
+                traceEvent_->arg[3] = d; \
+            } \
+        } while (0)
+#else
+#define gp_TraceEvent(theGraph, eventType, a, b, c, d) ((void) 0)
+#endif
+
+/********************************************************************
+ The allocation arena of a graph, used if ALLOCFLAGS_ARENA was set
+ with gp_SetAllocFlags() (see graphArena.c).
+        base: the arena memory, or NULL if there is no arena
+        size: the size of the arena memory
+        used: the number of bytes carved from the arena so far
+        allocFlags: the ALLOCFLAGS of the graph (see graph.h)
+        dirName: the directory of the file of an ALLOCFLAGS_FILEBACKED
+                 arena, or NULL for the default (see gp_SetArenaDirectory())
+*/
+
+typedef struct
+{
+    char *base;
+    size_t size, used;
+    int allocFlags;
+    char *dirName;
+} graphArena;
+
+/********************************************************************
+ graphAllocator
+ The functions with which a graph allocates the memory that is not
+ carved from its arena (see gp_SetAllocator() in graphArena.c)
+        fpAlloc, fpRealloc, fpFree: the counterparts of malloc(),
+                   realloc() and free(), which are also given the context
+        context: the data of the host allocator, such as its arena
+*/
+
+typedef struct
+{
+    void *(*fpAlloc)(void *context, size_t size);
+    void *(*fpRealloc)(void *context, void *memory, size_t size);
+    void (*fpFree)(void *context, void *memory);
+    void *context;
+} graphAllocator;
+
+typedef graphAllocator * graphAllocatorP;
+
+/********************************************************************
+ graphPoolLink
+ The membership of a graph in the graph pool (see graphPool.c)
+        algorithm: the embedFlags for which gp_PoolAcquire() made the
+                   graph, or 0 if the graph was not made by the pool
+        next: the next idle graph of the same size class in the pool
+*/
+
+typedef struct
+{
+    int algorithm;
+    void *next;
+} graphPoolLink;
+
 /********************************************************************
  Graph structure definition
         V : Array of vertex records (allocated size N + NV)
@@ -530,21 +936,48 @@ typedef isolatorContext * isolatorContextP;
         NV: Number of virtual vertices (currently always equal to N)
 
         E : Array of edge records (edge records come in pairs and represent half edges, or arcs)
+        ELink, ENeighbor, EFlags: the columns of E if EDGE_SOA is defined
         M: Number of edges (the "size" of the graph)
         arcCapacity: the maximum number of edge records allowed in E (the size of E)
         edgeHoles: free locations in E where edges have been deleted
+        edgeHighWater: the largest gp_EdgeInUseIndexBound() since the graph was
+                    initialized or reinitialized; the edge records from it up to
+                    the arc capacity have not been changed since then, in the
+                    graph or in any extension, so O(touched) reinitialization
+                    and copying can skip them
+        vertexVisitedStamp, edgeVisitedStamp: the current visited stamps of the
+                    vertex and edge records (see VISITED_STAMP_MASK)
 
         theStack: Used by various graph routines needing a stack
         internalFlags: Additional state information about the graph
         embedFlags: controls type of embedding (e.g. planar)
+        embedOptions: the EMBEDOPTIONS of the graph (see gp_SetEmbedOptions())
+        arcMap: during gp_Embed() with EMBEDOPTIONS_COMPACTARCS, the location to
+                which each of the first numMappedPairs edge record pairs was moved,
+                followed by the original location of the pair at each location
+                (see _CompactArcs() in graphEmbed.c); otherwise NULL
 
         IC: contains additional useful variables for Kuratowski subgraph isolation.
         BicompRootLists: storage space for pertinent bicomp root lists that develop
                         during embedding
         sortedDFSChildLists: storage for the sorted DFS child lists of each vertex
         extFace: Array of (N + NV) external face short circuit records
+        H: Array of (N + NV) hot vertex records if VERTEX_HOTREC is defined,
+           which replaces extFace; it is aligned within hotBlock
+
+        stats: timings of the phases of gp_Embed(), accumulated per graph
+        fpPhaseObserver: optional observer of the phase boundaries of gp_Embed()
+        phaseObserverContext: the context passed to fpPhaseObserver
+        trace: the ring buffer of trace events of the embedder
+        arena: the memory from which the arrays of the graph are carved,
+               if it was created with an arena (see gp_SetAllocFlags())
+        allocator: the allocator of all other memory of the graph, including
+               the graph record itself (see gp_NewWithAllocator())
+        pool: the membership of the graph in the graph pool
 
         extensions: a list of extension data structures
+        edgeColumns, vertexColumns: the blocks holding the per-edge and per-vertex
+                   columns of the extensions (see gp_AddExtensionColumn())
         functions: a table of function pointers that can be overloaded to provide
                    extension behaviors to the graph
 */
@@ -556,17 +989,37 @@ typedef struct
         int N, NV;
 
         edgeRecP E;
-        int M, arcCapacity;
+#ifdef EDGE_SOA
+        graphIndex *ELink, *ENeighbor;
+        graphFlags *EFlags;
+#endif
+        int M, arcCapacity, edgeHighWater;
         stackP edgeHoles;
 
+        unsigned vertexVisitedStamp, edgeVisitedStamp;
+
         stackP theStack;
-        int internalFlags, embedFlags;
+        int internalFlags, embedFlags, embedOptions;
+        int *arcMap, numMappedPairs;
 
         isolatorContext IC;
         listCollectionP BicompRootLists, sortedDFSChildLists;
         extFaceLinkRecP extFace;
+#ifdef VERTEX_HOTREC
+        vertexHotRecP H;
+        void *hotBlock;
+#endif
+
+        embedStats stats;
+        embedPhaseObserver fpPhaseObserver;
+        void *phaseObserverContext;
+        traceBuffer trace;
+        graphArena arena;
+        graphAllocator allocator;
+        graphPoolLink pool;
 
         graphExtensionP extensions;
+        graphColumnBlock edgeColumns, vertexColumns;
         graphFunctionTable functions;
 
 } baseGraphStructure;
@@ -584,12 +1037,18 @@ typedef baseGraphStructure * graphP;
                 gp_TestEmbedResultIntegrity() to decide what integrity tests to run.
         FLAGS_ZEROBASEDIO is typically set by gp_Read() to indicate that the
         		adjacency list representation began with index 0.
+        FLAGS_TRIMMED is set by gp_Trim() once the working storage of the
+                graph has been released, after which only reading, writing
+                and freeing the graph are supported.
 */
 
 #define FLAGS_DFSNUMBERED       1
 #define FLAGS_SORTEDBYDFI       2
 #define FLAGS_OBSTRUCTIONFOUND  4
 #define FLAGS_ZEROBASEDIO		8
+#define FLAGS_TRIMMED           16
+
+#define gp_IsTrimmed(theGraph) ((theGraph)->internalFlags & FLAGS_TRIMMED)
 
 /********************************************************************
  More link structure accessors/manipulators
@@ -601,12 +1060,12 @@ typedef baseGraphStructure * graphP;
 #define gp_GetNextArcCircular(theGraph, e) \
 	(gp_IsArc(gp_GetNextArc(theGraph, e)) ? \
 			gp_GetNextArc(theGraph, e) : \
-			gp_GetFirstArc(theGraph, theGraph->E[gp_GetTwinArc(theGraph, e)].neighbor))
+			gp_GetFirstArc(theGraph, gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e))))
 
 #define gp_GetPrevArcCircular(theGraph, e) \
 	(gp_IsArc(gp_GetPrevArc(theGraph, e)) ? \
 		gp_GetPrevArc(theGraph, e) : \
-		gp_GetLastArc(theGraph, theGraph->E[gp_GetTwinArc(theGraph, e)].neighbor))
+		gp_GetLastArc(theGraph, gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e))))
 
 // Definitions that make the cross-link binding between a vertex and an arc
 // The old first or last arc should be bound to this arc by separate calls,
@@ -762,12 +1221,12 @@ void 	gp_DetachArc(graphP theGraph, int arc);
 #define FUTUREPERTINENT(theGraph, theVertex, v) \
         (  theGraph->VI[theVertex].leastAncestor < v || \
            (gp_IsVertex(theGraph->VI[theVertex].futurePertinentChild) && \
-            theGraph->VI[theGraph->VI[theVertex].futurePertinentChild].lowpoint < v) )
+            gp_GetVertexLowpoint(theGraph, theGraph->VI[theVertex].futurePertinentChild) < v) )
 
 #define NOTFUTUREPERTINENT(theGraph, theVertex, v) \
         (  theGraph->VI[theVertex].leastAncestor >= v && \
            (gp_IsNotVertex(theGraph->VI[theVertex].futurePertinentChild) || \
-            theGraph->VI[theGraph->VI[theVertex].futurePertinentChild].lowpoint >= v) )
+            gp_GetVertexLowpoint(theGraph, theGraph->VI[theVertex].futurePertinentChild) >= v) )
 
 // This is the definition that would be preferrable if a while loop could be a void expression
 //#define FUTUREPERTINENT(theGraph, theVertex, v)
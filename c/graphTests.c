@@ -9,7 +9,7 @@ See the LICENSE.TXT file for licensing information.
 #include "graph.h"
 #include "stack.h"
 
-extern void _ClearVertexVisitedFlags(graphP theGraph, int);
+extern void _ClearVertexVisitedFlags(graphP theGraph);
 
 /* Private function declarations */
 
@@ -77,7 +77,7 @@ int gp_TestEmbedResultIntegrity(graphP theGraph, graphP origGraph, int embedResu
 {
 int RetVal = embedResult;
 
-    if (theGraph == NULL || origGraph == NULL)
+    if (theGraph == NULL || origGraph == NULL || gp_IsTrimmed(theGraph))
         return NOTOK;
 
     if (embedResult == OK)
@@ -191,7 +191,7 @@ int EsizeOccupied, v, e, eTwin, eStart, eNext, NumFaces, connectedComponents;
 
      // There are M edges, so we better have pushed 2M arcs just now
      // i.e. testing that the continue above skipped only edge holes
-     if (sp_GetCurrentSize(theStack) != 2*theGraph->M)
+     if (sp_GetCurrentSize(theStack) != 2 * (stackIndex) theGraph->M)
     	 return NOTOK;
 
 
@@ -259,7 +259,7 @@ int _CheckAllVerticesOnExternalFace(graphP theGraph)
     int v;
 
     // Mark all vertices unvisited
-    _ClearVertexVisitedFlags(theGraph, FALSE);
+    _ClearVertexVisitedFlags(theGraph);
 
     // For each connected component, walk its external face and
     // mark the vertices as visited
@@ -472,7 +472,7 @@ int _TestForCompleteGraphObstruction(graphP theGraph, int numVerts,
         return FALSE;
 
     // We clear all the vertex visited flags
-    _ClearVertexVisitedFlags(theGraph, FALSE);
+    _ClearVertexVisitedFlags(theGraph);
 
     // For each pair of image vertices, we test that there is a path
     // between the two vertices.  If so, the visited flags of the
@@ -552,7 +552,7 @@ int  v, K, imageVertPos, temp, success;
      /* Now test the paths between each of the first three vertices and
             each of the last three vertices */
 
-     _ClearVertexVisitedFlags(theGraph, FALSE);
+     _ClearVertexVisitedFlags(theGraph);
 
      for (imageVertPos=0; imageVertPos<3; imageVertPos++)
           for (K=3; K<6; K++)
@@ -678,7 +678,7 @@ int  v, e, imageVertPos;
           Now test the paths between each of the degree 2 image
           vertices and imageVerts[1]. */
 
-     _ClearVertexVisitedFlags(theGraph, FALSE);
+     _ClearVertexVisitedFlags(theGraph);
 
      for (imageVertPos=2; imageVertPos<5; imageVertPos++)
      {
@@ -884,7 +884,7 @@ int invokeSortOnSubgraph = FALSE;
 
 /* We clear all visitation flags */
 
-     _ClearVertexVisitedFlags(theGraph, FALSE);
+     _ClearVertexVisitedFlags(theGraph);
 
 /* For each vertex... */
      for (v = gp_GetFirstVertex(theSubgraph), degreeCount = 0; gp_VertexInRange(theSubgraph, v); v++)
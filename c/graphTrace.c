@@ -0,0 +1,121 @@
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+#define GRAPHTRACE_C
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "graph.h"
+
+/********************************************************************
+ gp_EnableTrace()
+ Gives theGraph a trace buffer that keeps its most recent capacity
+ embedder trace events (see traceBuffer in graphStructures.h), or
+ frees the trace buffer if capacity is zero.  The capacity is
+ rounded up to a power of two, and any prior events are discarded.
+ The trace buffer is kept until it is changed or the graph is
+ cleared by gp_Free() or a failed gp_InitGraph().
+
+ Returns OK, or NOTOK on a negative capacity, on an allocation error,
+ or if the library was not built with EMBEDTRACE
+ ********************************************************************/
+
+int  gp_EnableTrace(graphP theGraph, int capacity)
+{
+#ifdef EMBEDTRACE
+unsigned int ringSize = 1;
+#endif
+
+     if (theGraph == NULL || capacity < 0)
+         return NOTOK;
+
+     if (theGraph->trace.events != NULL)
+     {
+         gp_FreeMemory(theGraph, theGraph->trace.events);
+         theGraph->trace.events = NULL;
+     }
+     theGraph->trace.mask = 0;
+     theGraph->trace.numEvents = 0;
+
+     if (capacity == 0)
+         return OK;
+
+#ifndef EMBEDTRACE
+     return NOTOK;
+#else
+     while (ringSize < (unsigned int) capacity)
+         ringSize <<= 1;
+
+     if ((theGraph->trace.events = (traceEventP) gp_ReallocMemory(theGraph, NULL, ringSize * sizeof(traceEvent))) == NULL)
+         return NOTOK;
+
+     theGraph->trace.mask = ringSize - 1;
+     return OK;
+#endif
+}
+
+/********************************************************************
+ gp_ClearTrace()
+ Discards the events in the trace buffer of theGraph, if any.
+ ********************************************************************/
+
+void gp_ClearTrace(graphP theGraph)
+{
+     if (theGraph != NULL)
+         theGraph->trace.numEvents = 0;
+}
+
+/********************************************************************
+ gp_WriteTrace()
+ Writes the trace buffer of theGraph to the named binary file, as a
+ traceFileHeader (see graph.h) followed by the events in the ring,
+ oldest first.  The file is meant for the planarity-trace decoder,
+ and it uses the byte order and int size of the writing machine.
+
+ Returns OK, or NOTOK if tracing is not enabled or on a write error
+ ********************************************************************/
+
+int  gp_WriteTrace(graphP theGraph, char *FileName)
+{
+traceFileHeader header;
+unsigned long long first;
+unsigned int capacity, i;
+FILE *outfile;
+int  RetVal = OK;
+
+     if (theGraph == NULL || FileName == NULL || theGraph->trace.events == NULL)
+         return NOTOK;
+
+     capacity = theGraph->trace.mask + 1;
+
+     header.magic = TRACEFILE_MAGIC;
+     header.version = TRACEFILE_VERSION;
+     header.eventSize = sizeof(traceEvent);
+     header.capacity = capacity;
+     header.numEvents = theGraph->trace.numEvents;
+     header.numRecorded = (unsigned int) MIN(theGraph->trace.numEvents, (unsigned long long) capacity);
+     header.reserved = 0;
+
+     if ((outfile = fopen(FileName, "wb")) == NULL)
+         return NOTOK;
+
+     if (fwrite(&header, sizeof(traceFileHeader), 1, outfile) != 1)
+         RetVal = NOTOK;
+
+     first = theGraph->trace.numEvents - header.numRecorded;
+     for (i = 0; i < header.numRecorded && RetVal == OK; i++)
+     {
+         if (fwrite(theGraph->trace.events + ((first + i) & theGraph->trace.mask),
+                    sizeof(traceEvent), 1, outfile) != 1)
+             RetVal = NOTOK;
+     }
+
+     if (fclose(outfile) != 0)
+         RetVal = NOTOK;
+
+     return RetVal;
+}
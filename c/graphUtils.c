@@ -42,7 +42,7 @@ int  _RestoreVertex(graphP theGraph);
 
 void _InitIsolatorContext(graphP theGraph);
 void _ClearVisitedFlags(graphP theGraph);
-void _ClearVertexVisitedFlags(graphP theGraph, int);
+void _ClearVertexVisitedFlags(graphP theGraph);
 void _ClearEdgeVisitedFlags(graphP theGraph);
 int  _ClearVisitedFlagsInBicomp(graphP theGraph, int BicompRoot);
 int  _ClearVisitedFlagsInOtherBicomps(graphP theGraph, int BicompRoot);
@@ -51,8 +51,8 @@ int  _FillVertexVisitedInfoInBicomp(graphP theGraph, int BicompRoot, int FillVal
 int  _ClearVertexTypeInBicomp(graphP theGraph, int BicompRoot);
 
 int  _HideInternalEdges(graphP theGraph, int vertex);
-int  _RestoreInternalEdges(graphP theGraph, int stackBottom);
-int  _RestoreHiddenEdges(graphP theGraph, int stackBottom);
+int  _RestoreInternalEdges(graphP theGraph, stackIndex stackBottom);
+int  _RestoreHiddenEdges(graphP theGraph, stackIndex stackBottom);
 
 int  _GetBicompSize(graphP theGraph, int BicompRoot);
 int  _DeleteUnmarkedEdgesInBicomp(graphP theGraph, int BicompRoot);
@@ -66,9 +66,18 @@ void _InitFunctionTable(graphP theGraph);
 
 void _InitVertices(graphP theGraph);
 void _InitEdges(graphP theGraph);
+void _SetEdgeColumns(graphP theGraph, edgeRecP E, int Esize);
+void _ClearEdgeRecords(graphP theGraph, int e, int count);
 
 void _ClearGraph(graphP theGraph);
 
+extern int  _CreateArena(graphP theGraph, int N);
+extern void _FreeArena(graphP theGraph);
+extern void _AdviseRandomAccess(graphP theGraph, void *memory, size_t size);
+
+extern int  _LayoutExtensionColumns(graphP theGraph, int columnFlags, int columnSize, int copySize);
+extern void _InitExtensionColumns(graphP theGraph, int columnType, int bound);
+
 int  _GetRandomNumber(int NMin, int NMax);
 
 /* Private functions for which there are FUNCTION POINTERS */
@@ -80,20 +89,51 @@ void _InitEdgeRec(graphP theGraph, int e);
 int  _InitGraph(graphP theGraph, int N);
 void _ReinitializeGraph(graphP theGraph);
 int  _EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
+int  _TrimGraph(graphP theGraph);
 
 /********************************************************************
  gp_New()
  Constructor for graph object.
  Can create two graphs if restricted to no dynamic memory.
+ The graph uses the default allocator (see gp_SetAllocator()).
  ********************************************************************/
 
 graphP gp_New()
 {
-graphP theGraph = (graphP) malloc(sizeof(baseGraphStructure));
+     return gp_NewWithAllocator(NULL);
+}
+
+/********************************************************************
+ gp_NewWithAllocator()
+ Constructor for a graph object whose memory, including the graph
+ record, is allocated with a copy of theAllocator, or with the default
+ allocator if theAllocator is NULL (see graphArena.c).
+
+ Returns the graph, or NULL on failure or if any of the functions of
+ theAllocator is NULL
+ ********************************************************************/
+
+graphP gp_NewWithAllocator(graphAllocatorP theAllocator)
+{
+graphAllocator allocator;
+graphP theGraph;
+
+     gp_GetAllocator(&allocator);
+     if (theAllocator != NULL)
+     {
+         if (theAllocator->fpAlloc == NULL || theAllocator->fpRealloc == NULL ||
+             theAllocator->fpFree == NULL)
+             return NULL;
+         allocator = *theAllocator;
+     }
+
+     theGraph = (graphP) allocator.fpAlloc(allocator.context, sizeof(baseGraphStructure));
 
      if (theGraph != NULL)
      {
-         theGraph->E = NULL;
+         theGraph->allocator = allocator;
+
+         _SetEdgeColumns(theGraph, NULL, 0);
          theGraph->V = NULL;
          theGraph->VI = NULL;
 
@@ -102,10 +142,26 @@ graphP theGraph = (graphP) malloc(sizeof(baseGraphStructure));
          theGraph->theStack = NULL;
 
          theGraph->extFace = NULL;
+#ifdef VERTEX_HOTREC
+         theGraph->H = NULL;
+         theGraph->hotBlock = NULL;
+#endif
 
          theGraph->edgeHoles = NULL;
 
          theGraph->extensions = NULL;
+         theGraph->edgeColumns.base = theGraph->vertexColumns.base = NULL;
+         theGraph->edgeColumns.size = theGraph->vertexColumns.size = 0;
+
+         theGraph->trace.events = NULL;
+
+         theGraph->arena.base = NULL;
+         theGraph->arena.allocFlags = 0;
+         theGraph->arena.dirName = NULL;
+         theGraph->pool.algorithm = 0;
+         theGraph->pool.next = NULL;
+         theGraph->embedOptions = 0;
+         theGraph->arcMap = NULL;
 
          _InitFunctionTable(theGraph);
 
@@ -147,6 +203,7 @@ void _InitFunctionTable(graphP theGraph)
      theGraph->functions.fpInitGraph = _InitGraph;
      theGraph->functions.fpReinitializeGraph = _ReinitializeGraph;
      theGraph->functions.fpEnsureArcCapacity = _EnsureArcCapacity;
+     theGraph->functions.fpTrimGraph = _TrimGraph;
      theGraph->functions.fpSortVertices = _SortVertices;
 
      theGraph->functions.fpReadPostprocess = _ReadPostprocess;
@@ -197,12 +254,23 @@ int gp_InitGraph(graphP theGraph, int N)
 	if (theGraph->N)
 		return NOTOK;
 
+	// The vertex and edge index bounds must fit in a graphIndex
+	if (gp_GetFirstVertex(theGraph) + 2 * (long long) N > GRAPHINDEX_MAX ||
+		gp_GetFirstEdge(theGraph) +
+			(theGraph->arcCapacity > 0 ? theGraph->arcCapacity : 2 * DEFAULT_EDGE_LIMIT * (long long) N) > GRAPHINDEX_MAX)
+		return NOTOK;
+
+	// Reserve the arena, if requested, before any extension allocates its
+	// arrays; if it cannot be reserved, the arrays are allocated separately
+	_CreateArena(theGraph, N);
+
     return theGraph->functions.fpInitGraph(theGraph, N);
 }
 
 int  _InitGraph(graphP theGraph, int N)
 {
-	 int  Vsize, VIsize, Esize, stackSize;
+	 int  Vsize, VIsize, Esize;
+	 stackIndex stackSize;
 
 	 // Compute the vertex and edge capacities of the graph
      theGraph->N = N;
@@ -213,29 +281,50 @@ int  _InitGraph(graphP theGraph, int N)
      Esize = gp_EdgeIndexBound(theGraph);
 
      // Stack size is 2 integers per arc, or 6 integers per vertex in case of small arcCapacity
-     stackSize = 2 * Esize;
-     stackSize = stackSize < 6*N ? 6*N : stackSize;
-
-     // Allocate memory as described above
-     if ((theGraph->V = (vertexRecP) calloc(Vsize, sizeof(vertexRec))) == NULL ||
-    	 (theGraph->VI = (vertexInfoP) calloc(VIsize, sizeof(vertexInfo))) == NULL ||
-    	 (theGraph->E = (edgeRecP) calloc(Esize, sizeof(edgeRec))) == NULL ||
-         (theGraph->BicompRootLists = LCNew(VIsize)) == NULL ||
-         (theGraph->sortedDFSChildLists = LCNew(VIsize)) == NULL ||
-         (theGraph->theStack = sp_New(stackSize)) == NULL ||
-         (theGraph->extFace = (extFaceLinkRecP) calloc(Vsize, sizeof(extFaceLinkRec))) == NULL ||
-         (theGraph->edgeHoles = sp_New(Esize / 2)) == NULL ||
+     stackSize = 2 * (stackIndex) Esize;
+     stackSize = stackSize < 6 * (stackIndex) N ? 6 * (stackIndex) N : stackSize;
+
+     // Allocate memory as described above, from the arena if there is one.
+     // The vertex and edge arrays are fully initialized below.
+     if ((theGraph->V = (vertexRecP) gp_AllocMemory(theGraph, Vsize * sizeof(vertexRec))) == NULL ||
+    	 (theGraph->VI = (vertexInfoP) gp_AllocMemory(theGraph, VIsize * sizeof(vertexInfo))) == NULL ||
+    	 (theGraph->E = (edgeRecP) gp_AllocMemory(theGraph, Esize * sizeof(edgeRec))) == NULL ||
+         (theGraph->BicompRootLists = gp_NewListCollection(theGraph, VIsize)) == NULL ||
+         (theGraph->sortedDFSChildLists = gp_NewListCollection(theGraph, VIsize)) == NULL ||
+         (theGraph->theStack = gp_NewStack(theGraph, stackSize)) == NULL ||
+#ifdef VERTEX_HOTREC
+         (theGraph->hotBlock = gp_AllocMemory(theGraph, Vsize * sizeof(vertexHotRec) + VERTEX_HOTREC_ALIGNMENT)) == NULL ||
+#else
+         (theGraph->extFace = (extFaceLinkRecP) gp_AllocMemory(theGraph, Vsize * sizeof(extFaceLinkRec))) == NULL ||
+#endif
+         (theGraph->edgeHoles = gp_NewStack(theGraph, Esize / 2)) == NULL ||
          0)
      {
          _ClearGraph(theGraph);
          return NOTOK;
      }
+     _SetEdgeColumns(theGraph, theGraph->E, Esize);
+     _AdviseRandomAccess(theGraph, theGraph->E, Esize * sizeof(edgeRec));
+#ifdef VERTEX_HOTREC
+     theGraph->H = (vertexHotRecP) (((size_t) theGraph->hotBlock + VERTEX_HOTREC_ALIGNMENT - 1) &
+                                    ~((size_t) VERTEX_HOTREC_ALIGNMENT - 1));
+#endif
 
-     // Initialize memory
+     // Initialize memory.  All of the new edge records must be initialized,
+     // so the edge high water mark starts at the end of the edge array.
+     theGraph->edgeHighWater = Esize;
      _InitVertices(theGraph);
      _InitEdges(theGraph);
      _InitIsolatorContext(theGraph);
 
+     // Allocate and initialize the columns of the extensions
+     if (_LayoutExtensionColumns(theGraph, COLUMNFLAGS_EDGE, Esize, 0) != OK ||
+         _LayoutExtensionColumns(theGraph, COLUMNFLAGS_VERTEX, VIsize, 0) != OK)
+     {
+         _ClearGraph(theGraph);
+         return NOTOK;
+     }
+
      return OK;
 }
 
@@ -247,13 +336,21 @@ void _InitVertices(graphP theGraph)
 #if NIL == 0
 	memset(theGraph->V, NIL_CHAR, gp_VertexIndexBound(theGraph) * sizeof(vertexRec));
 	memset(theGraph->VI, NIL_CHAR, gp_PrimaryVertexIndexBound(theGraph) * sizeof(vertexInfo));
+#ifdef VERTEX_HOTREC
+	memset(theGraph->H, NIL_CHAR, gp_VertexIndexBound(theGraph) * sizeof(vertexHotRec));
+#else
 	memset(theGraph->extFace, NIL_CHAR, gp_VertexIndexBound(theGraph) * sizeof(extFaceLinkRec));
+#endif
 #elif NIL == -1
 	int v;
 
 	memset(theGraph->V, NIL_CHAR, gp_VertexIndexBound(theGraph) * sizeof(vertexRec));
 	memset(theGraph->VI, NIL_CHAR, gp_PrimaryVertexIndexBound(theGraph) * sizeof(vertexInfo));
+#ifdef VERTEX_HOTREC
+	memset(theGraph->H, NIL_CHAR, gp_VertexIndexBound(theGraph) * sizeof(vertexHotRec));
+#else
 	memset(theGraph->extFace, NIL_CHAR, gp_VertexIndexBound(theGraph) * sizeof(extFaceLinkRec));
+#endif
 
 	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
 	    gp_InitVertexFlags(theGraph, v);
@@ -282,38 +379,89 @@ void _InitVertices(graphP theGraph)
 
 /********************************************************************
  _InitEdges()
+ Initializes the edge records below the edge high water mark, which
+ are the only ones that may have changed since the last initialization,
+ then lowers the mark to the first edge.
  ********************************************************************/
 void _InitEdges(graphP theGraph)
 {
+	int Esize = gp_EdgeTouchedIndexBound(theGraph);
+
 #if NIL == 0
-	memset(theGraph->E, NIL_CHAR, gp_EdgeIndexBound(theGraph) * sizeof(edgeRec));
+	_ClearEdgeRecords(theGraph, 0, Esize);
 #elif NIL == -1
-	int e, Esize;
+	int e;
 
-	memset(theGraph->E, NIL_CHAR, gp_EdgeIndexBound(theGraph) * sizeof(edgeRec));
+	_ClearEdgeRecords(theGraph, 0, Esize);
 
-	Esize = gp_EdgeIndexBound(theGraph);
     for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
         gp_InitEdgeFlags(theGraph, e);
 
 #else
-	int e, Esize;
+	int e;
 
-	Esize = gp_EdgeIndexBound(theGraph);
     for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
          _InitEdgeRec(theGraph, e);
 #endif
+
+    theGraph->edgeHighWater = gp_GetFirstEdge(theGraph);
+}
+
+/********************************************************************
+ _SetEdgeColumns()
+ Sets the edge array E of theGraph, which has Esize edge records.
+ If EDGE_SOA is defined, E is carved into the columns of the members
+ of the edge records (see gp_EdgeLink()).
+ ********************************************************************/
+void _SetEdgeColumns(graphP theGraph, edgeRecP E, int Esize)
+{
+	theGraph->E = E;
+
+#ifdef EDGE_SOA
+	if (E == NULL)
+	{
+		theGraph->ELink = theGraph->ENeighbor = NULL;
+		theGraph->EFlags = NULL;
+		return;
+	}
+
+	theGraph->ELink = (graphIndex *) E;
+	theGraph->ENeighbor = theGraph->ELink + 2*Esize;
+	theGraph->EFlags = (graphFlags *) (theGraph->ENeighbor + Esize);
+#else
+	(void) Esize;
+#endif
+}
+
+/********************************************************************
+ _ClearEdgeRecords()
+ Sets all bytes of the count edge records starting at e to NIL_CHAR
+ ********************************************************************/
+void _ClearEdgeRecords(graphP theGraph, int e, int count)
+{
+#ifdef EDGE_SOA
+	memset(&gp_EdgeLink(theGraph, e, 0), NIL_CHAR, 2 * count * sizeof(graphIndex));
+	memset(&gp_EdgeNeighbor(theGraph, e), NIL_CHAR, count * sizeof(graphIndex));
+	memset(&gp_EdgeFlags(theGraph, e), NIL_CHAR, count * sizeof(graphFlags));
+#else
+	memset(theGraph->E + e, NIL_CHAR, count * sizeof(edgeRec));
+#endif
 }
 
 /********************************************************************
  gp_ReinitializeGraph()
  Reinitializes a graph, restoring it to the state it was in immediately
  after gp_InitGraph() processed it.
+
+ The vertices are all reinitialized, but only the edge records below
+ the edge high water mark are, so the cost is proportional to the most
+ edges the graph has held since it was last initialized rather than
+ to its arc capacity.
  ********************************************************************/
 
 void gp_ReinitializeGraph(graphP theGraph)
 {
-	if (theGraph == NULL || theGraph->N <= 0)
+	if (theGraph == NULL || theGraph->N <= 0 || gp_IsTrimmed(theGraph))
 		return;
 
     theGraph->functions.fpReinitializeGraph(theGraph);
@@ -324,6 +472,11 @@ void _ReinitializeGraph(graphP theGraph)
      theGraph->M = 0;
      theGraph->internalFlags = theGraph->embedFlags = 0;
 
+     // The edge columns of the extensions, like the edge records, need
+     // only be reinitialized below the edge high water mark
+     _InitExtensionColumns(theGraph, COLUMNFLAGS_VERTEX, gp_PrimaryVertexIndexBound(theGraph));
+     _InitExtensionColumns(theGraph, COLUMNFLAGS_EDGE, gp_EdgeTouchedIndexBound(theGraph));
+
      _InitVertices(theGraph);
      _InitEdges(theGraph);
      _InitIsolatorContext(theGraph);
@@ -334,6 +487,65 @@ void _ReinitializeGraph(graphP theGraph)
      sp_ClearStack(theGraph->edgeHoles);
 }
 
+/********************************************************************
+ gp_GetMemoryUsage()
+ Reports the bytes allocated for theGraph by component, including the
+ contexts of extensions that provide a getMemoryUsage function (see
+ gp_AddExtension()).  The arrays are counted at their allocated sizes,
+ so the usage depends on N and the arc capacity, not on M.
+
+ Returns OK, or NOTOK for invalid parameters
+ ********************************************************************/
+
+int gp_GetMemoryUsage(graphP theGraph, graphMemoryUsageP pUsage)
+{
+graphExtensionP extension;
+
+     if (theGraph == NULL || pUsage == NULL)
+         return NOTOK;
+
+     memset(pUsage, 0, sizeof(graphMemoryUsage));
+
+     pUsage->graph = sizeof(baseGraphStructure);
+
+     if (theGraph->V != NULL)
+         pUsage->vertexRecs = (gp_IsTrimmed(theGraph) ? gp_PrimaryVertexIndexBound(theGraph) :
+                               gp_VertexIndexBound(theGraph)) * sizeof(vertexRec);
+     if (theGraph->VI != NULL)
+         pUsage->vertexInfos = gp_PrimaryVertexIndexBound(theGraph) * sizeof(vertexInfo);
+     if (theGraph->E != NULL)
+         pUsage->edgeRecs = gp_EdgeIndexBound(theGraph) * sizeof(edgeRec);
+     if (theGraph->extFace != NULL)
+         pUsage->extFace = gp_VertexIndexBound(theGraph) * sizeof(extFaceLinkRec);
+#ifdef VERTEX_HOTREC
+     if (theGraph->hotBlock != NULL)
+         pUsage->vertexRecs += gp_VertexIndexBound(theGraph) * sizeof(vertexHotRec) + VERTEX_HOTREC_ALIGNMENT;
+#endif
+
+     pUsage->listCollections = LCGetMemoryUsage(theGraph->BicompRootLists) +
+                               LCGetMemoryUsage(theGraph->sortedDFSChildLists);
+     pUsage->stacks = sp_GetMemoryUsage(theGraph->theStack) +
+                      sp_GetMemoryUsage(theGraph->edgeHoles);
+
+     if (theGraph->trace.events != NULL)
+         pUsage->trace = (theGraph->trace.mask + 1) * sizeof(traceEvent);
+
+     pUsage->extensions = theGraph->edgeColumns.size + theGraph->vertexColumns.size;
+     for (extension = theGraph->extensions; extension != NULL;
+          extension = (graphExtensionP) extension->next)
+     {
+         pUsage->graph += sizeof(graphExtension) + extension->numColumns * sizeof(graphColumn);
+         if (extension->getMemoryUsage != NULL && extension->context != NULL)
+             pUsage->extensions += extension->getMemoryUsage(extension->context);
+     }
+
+     pUsage->total = pUsage->graph + pUsage->vertexRecs + pUsage->vertexInfos +
+                     pUsage->edgeRecs + pUsage->extFace + pUsage->listCollections +
+                     pUsage->stacks + pUsage->extensions + pUsage->trace;
+
+     return OK;
+}
+
 /********************************************************************
  gp_GetArcCapacity()
  Returns the arcCapacity of theGraph, which is twice the maximum
@@ -397,7 +609,7 @@ int gp_GetArcCapacity(graphP theGraph)
  ********************************************************************/
 int gp_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
 {
-	if (theGraph == NULL || requiredArcCapacity <= 0)
+	if (theGraph == NULL || requiredArcCapacity <= 0 || gp_IsTrimmed(theGraph))
 		return NOTOK;
 
 	// Train callers to only ask for an even number of arcs, since
@@ -405,6 +617,10 @@ int gp_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
 	if (requiredArcCapacity & 1)
 		return NOTOK;
 
+	// The edge index bound must fit in a graphIndex
+	if (gp_GetFirstEdge(theGraph) + (long long) requiredArcCapacity > GRAPHINDEX_MAX)
+		return NOTOK;
+
     if (theGraph->arcCapacity >= requiredArcCapacity)
     	return OK;
 
@@ -433,11 +649,11 @@ int e, Esize = gp_EdgeIndexBound(theGraph),
 		return OK;
 
     // Expand theStack
-    if (sp_GetCapacity(theGraph->theStack) < 2 * requiredArcCapacity)
+    if (sp_GetCapacity(theGraph->theStack) < 2 * (stackIndex) requiredArcCapacity)
     {
-    	int stackSize = 2 * requiredArcCapacity;
+    	stackIndex stackSize = 2 * (stackIndex) requiredArcCapacity;
 
-    	if (stackSize < 6*theGraph->N)
+    	if (stackSize < 6 * (stackIndex) theGraph->N)
     	{
 			// NOTE: Since this routine only makes the stack bigger, this
     		//       calculation is not needed here because we already ensured
@@ -445,27 +661,55 @@ int e, Esize = gp_EdgeIndexBound(theGraph),
     		//       But we do it for clarity and consistency (e.g. so this rule
     		//       is not forgotten whenever a "SetArcCapacity" method or a
     		//       "reduceArcCapacity" method is added)
-    		stackSize = 6*theGraph->N;
+    		stackSize = 6 * (stackIndex) theGraph->N;
     	}
 
-    	if ((newStack = sp_New(stackSize)) == NULL)
+    	if ((newStack = gp_NewStack(theGraph, stackSize)) == NULL)
     		return NOTOK;
 
     	sp_CopyContent(newStack, theGraph->theStack);
-    	sp_Free(&theGraph->theStack);
+    	gp_FreeStack(theGraph, &theGraph->theStack);
     	theGraph->theStack = newStack;
     }
 
 	// Expand edgeHoles
-    if ((newStack = sp_New(requiredArcCapacity / 2)) == NULL)
+    if ((newStack = gp_NewStack(theGraph, requiredArcCapacity / 2)) == NULL)
     	return NOTOK;
 
 	sp_CopyContent(newStack, theGraph->edgeHoles);
-    sp_Free(&theGraph->edgeHoles);
+    gp_FreeStack(theGraph, &theGraph->edgeHoles);
     theGraph->edgeHoles = newStack;
 
-	// Reallocate the edgeRec array to the new size,
-    theGraph->E = (edgeRecP) realloc(theGraph->E, newEsize*sizeof(edgeRec));
+	// Reallocate the edgeRec array to the new size, or if the graph has an arena,
+    // carve a new one since arena memory cannot be reallocated.  The columns
+    // of a structure of arrays are placed by the array size, so they are
+    // likewise copied into a new array rather than reallocated.
+#ifndef EDGE_SOA
+    if (theGraph->arena.base == NULL)
+        theGraph->E = (edgeRecP) gp_ReallocMemory(theGraph, theGraph->E, newEsize*sizeof(edgeRec));
+    else
+#endif
+    {
+        edgeRecP newE = (edgeRecP) gp_AllocMemory(theGraph, newEsize*sizeof(edgeRec));
+
+        if (newE != NULL)
+        {
+#ifdef EDGE_SOA
+        	baseGraphStructure newGraph;
+
+        	_SetEdgeColumns(&newGraph, newE, newEsize);
+        	memcpy(newGraph.ELink, theGraph->ELink, 2*Esize*sizeof(graphIndex));
+        	memcpy(newGraph.ENeighbor, theGraph->ENeighbor, Esize*sizeof(graphIndex));
+        	memcpy(newGraph.EFlags, theGraph->EFlags, Esize*sizeof(graphFlags));
+#else
+            memcpy(newE, theGraph->E, Esize*sizeof(edgeRec));
+#endif
+            _AdviseRandomAccess(theGraph, newE, newEsize*sizeof(edgeRec));
+        }
+        gp_FreeMemory(theGraph, theGraph->E);
+        theGraph->E = newE;
+    }
+    _SetEdgeColumns(theGraph, theGraph->E, newEsize);
     if (theGraph->E == NULL)
     	return NOTOK;
 
@@ -473,11 +717,149 @@ int e, Esize = gp_EdgeIndexBound(theGraph),
     for (e = Esize; e < newEsize; e++)
          _InitEdgeRec(theGraph, e);
 
+    // Grow the edge columns of the extensions likewise
+    if (_LayoutExtensionColumns(theGraph, COLUMNFLAGS_EDGE, newEsize, Esize) != OK)
+    	return NOTOK;
+
     // The new arcCapacity has been successfully achieved
 	theGraph->arcCapacity = requiredArcCapacity;
 	return OK;
 }
 
+/********************************************************************
+ gp_Trim()
+ Releases the memory that theGraph only needs for embedding, so that
+ a finished embedding (or isolated obstruction) can be kept at little
+ more than the size of its vertex and edge records.
+
+ The edge records are shrunk to those below gp_EdgeInUseIndexBound(),
+ which becomes the arc capacity, and the edgeHoles stack is shrunk to
+ match.  The vertex records are shrunk to the primary vertices, since
+ the bicomps of an embedding or obstruction are joined, which leaves
+ the virtual vertices empty.  The hot vertex records of VERTEX_HOTREC
+ builds are kept whole, with the external face links they share, since
+ they are an aligned block that cannot be reallocated.  The vertexInfo
+ records, the external face links, the stack and both list collections
+ are freed.  Extensions overload fpTrimGraph() to release their own
+ working data while keeping any results that must survive.
+
+ A trimmed graph is meant to be read: its adjacency lists can be
+ traversed, it can be written by gp_Write() (except as WRITE_DEBUGINFO),
+ its memory usage reported, and it can be freed.  gp_Embed(), vertex
+ sorting and the DFS functions, gp_ReinitializeGraph(), copying,
+ gp_EnsureArcCapacity() and gp_TestEmbedResultIntegrity() fail on it,
+ so sort the vertices (if desired) and test the result before trimming.
+
+ The memory of a graph with an arena (see gp_SetAllocFlags()) is only
+ released as a whole, so such a graph is not trimmed.
+
+ Returns OK on success or if theGraph is already trimmed, NOTOK if the
+         graph is not initialized, has an arena, or fails to be trimmed
+ ********************************************************************/
+
+int  gp_Trim(graphP theGraph)
+{
+	if (theGraph == NULL || theGraph->N <= 0 || theGraph->arena.base != NULL)
+		return NOTOK;
+
+	if (gp_IsTrimmed(theGraph))
+		return OK;
+
+	if (theGraph->functions.fpTrimGraph(theGraph) != OK)
+		return NOTOK;
+
+	theGraph->internalFlags |= FLAGS_TRIMMED;
+	return OK;
+}
+
+int  _TrimGraph(graphP theGraph)
+{
+stackP newStack;
+vertexRecP newV;
+int Esize = gp_EdgeIndexBound(theGraph),
+	newEsize = gp_EdgeInUseIndexBound(theGraph);
+
+	// The arc capacity is kept positive
+	if (newEsize < gp_GetFirstEdge(theGraph) + 2)
+		newEsize = gp_GetFirstEdge(theGraph) + 2;
+
+	// Shrink edgeHoles to the new arc capacity, which it still fits
+	if (newEsize < Esize)
+	{
+		if ((newStack = gp_NewStack(theGraph, (newEsize - gp_GetFirstEdge(theGraph)) / 2)) == NULL)
+			return NOTOK;
+
+		sp_CopyContent(newStack, theGraph->edgeHoles);
+		gp_FreeStack(theGraph, &theGraph->edgeHoles);
+		theGraph->edgeHoles = newStack;
+	}
+
+	// Shrink the edgeRec array.  The columns of a structure of arrays are
+	// placed by the array size, so they are copied into a new array.
+	if (newEsize < Esize)
+	{
+#ifdef EDGE_SOA
+		edgeRecP newE = (edgeRecP) gp_AllocMemory(theGraph, newEsize*sizeof(edgeRec));
+		baseGraphStructure newGraph;
+
+		if (newE == NULL)
+			return NOTOK;
+
+		_SetEdgeColumns(&newGraph, newE, newEsize);
+		memcpy(newGraph.ELink, theGraph->ELink, 2*newEsize*sizeof(graphIndex));
+		memcpy(newGraph.ENeighbor, theGraph->ENeighbor, newEsize*sizeof(graphIndex));
+		memcpy(newGraph.EFlags, theGraph->EFlags, newEsize*sizeof(graphFlags));
+		gp_FreeMemory(theGraph, theGraph->E);
+		theGraph->E = newE;
+#else
+		edgeRecP newE = (edgeRecP) gp_ReallocMemory(theGraph, theGraph->E, newEsize*sizeof(edgeRec));
+
+		if (newE != NULL)
+			theGraph->E = newE;
+#endif
+		_SetEdgeColumns(theGraph, theGraph->E, newEsize);
+
+		theGraph->arcCapacity = newEsize - gp_GetFirstEdge(theGraph);
+		if (theGraph->edgeHighWater > newEsize)
+			theGraph->edgeHighWater = newEsize;
+	}
+
+	// Shrink the vertex records to the primary vertices.  A failure to
+	// shrink keeps the larger array, which is still valid.
+	newV = (vertexRecP) gp_ReallocMemory(theGraph, theGraph->V, gp_PrimaryVertexIndexBound(theGraph)*sizeof(vertexRec));
+	if (newV != NULL)
+		theGraph->V = newV;
+
+	// Keep only the extension columns that hold results, shrinking those
+	// that are per edge along with the edge records
+	if (_LayoutExtensionColumns(theGraph, COLUMNFLAGS_EDGE | COLUMNFLAGS_KEEPONTRIM, newEsize, newEsize) != OK ||
+		_LayoutExtensionColumns(theGraph, COLUMNFLAGS_VERTEX | COLUMNFLAGS_KEEPONTRIM,
+								gp_PrimaryVertexIndexBound(theGraph), gp_PrimaryVertexIndexBound(theGraph)) != OK)
+		return NOTOK;
+
+	// Free the structures only used while embedding
+	if (theGraph->VI != NULL)
+	{
+		gp_FreeMemory(theGraph, theGraph->VI);
+		theGraph->VI = NULL;
+	}
+	if (theGraph->extFace != NULL)
+	{
+		gp_FreeMemory(theGraph, theGraph->extFace);
+		theGraph->extFace = NULL;
+	}
+	if (theGraph->arcMap != NULL)
+	{
+		gp_FreeMemory(theGraph, theGraph->arcMap);
+		theGraph->arcMap = NULL;
+	}
+	gp_FreeListCollection(theGraph, &theGraph->BicompRootLists);
+	gp_FreeListCollection(theGraph, &theGraph->sortedDFSChildLists);
+	gp_FreeStack(theGraph, &theGraph->theStack);
+
+	return OK;
+}
+
 /********************************************************************
  _InitVertexRec()
  Sets the fields in a single vertex record to initial values
@@ -542,37 +924,62 @@ isolatorContextP IC = &theGraph->IC;
 
 void _ClearVisitedFlags(graphP theGraph)
 {
-	 _ClearVertexVisitedFlags(theGraph, TRUE);
+	 _ClearVertexVisitedFlags(theGraph);
 	 _ClearEdgeVisitedFlags(theGraph);
 }
 
 /********************************************************************
  _ClearVertexVisitedFlags()
+
+ Clears the visited flags of all vertices by advancing the vertex
+ visited stamp of the graph, which takes constant time except once
+ per 255 calls, when the stamp wraps around and the stale stamps in
+ the vertex records are swept out.
+
+ Since the stamp is shared by vertices and virtual vertices, the
+ visited flags of the virtual vertices are cleared as well.
  ********************************************************************/
 
-void _ClearVertexVisitedFlags(graphP theGraph, int includeVirtualVertices)
+void _ClearVertexVisitedFlags(graphP theGraph)
 {
-	int  v;
+	int  v, Vsize;
 
-	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
-        gp_ClearVertexVisited(theGraph, v);
+	if (theGraph->vertexVisitedStamp < VISITED_STAMP_MASK)
+	{
+		theGraph->vertexVisitedStamp += VISITED_STAMP_INCREMENT;
+		return;
+	}
+
+	Vsize = gp_VertexIndexBound(theGraph);
+	for (v = gp_GetFirstVertex(theGraph); v < Vsize; v++)
+		gp_ClearVertexVisited(theGraph, v);
 
-	if (includeVirtualVertices)
-		for (v = gp_GetFirstVirtualVertex(theGraph); gp_VirtualVertexInRange(theGraph, v); v++)
-	        gp_ClearVertexVisited(theGraph, v);
+	theGraph->vertexVisitedStamp = VISITED_STAMP_INCREMENT;
 }
 
 /********************************************************************
  _ClearEdgeVisitedFlags()
+
+ Clears the visited flags of all edge records by advancing the edge
+ visited stamp of the graph, as in _ClearVertexVisitedFlags().
  ********************************************************************/
 
 void _ClearEdgeVisitedFlags(graphP theGraph)
 {
-	 int  e, EsizeOccupied;
+	int  e, Esize;
+
+	if (theGraph->edgeVisitedStamp < VISITED_STAMP_MASK)
+	{
+		theGraph->edgeVisitedStamp += VISITED_STAMP_INCREMENT;
+		return;
+	}
 
-	 EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
-     for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e++)
-    	 gp_ClearEdgeVisited(theGraph, e);
+	// Edge records at or above the high water mark are known to be clear
+	Esize = gp_EdgeTouchedIndexBound(theGraph);
+	for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
+		gp_ClearEdgeVisited(theGraph, e);
+
+	theGraph->edgeVisitedStamp = VISITED_STAMP_INCREMENT;
 }
 
 /********************************************************************
@@ -590,7 +997,7 @@ void _ClearEdgeVisitedFlags(graphP theGraph)
 
 int  _ClearVisitedFlagsInBicomp(graphP theGraph, int BicompRoot)
 {
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+stackIndex stackBottom = sp_GetCurrentSize(theGraph->theStack);
 int  v, e;
 
      sp_Push(theGraph->theStack, BicompRoot);
@@ -764,7 +1171,7 @@ int  _SetVisitedFlagsOnPath(graphP theGraph, int u, int v, int w, int x)
 int  _FillVertexVisitedInfoInBicomp(graphP theGraph, int BicompRoot, int FillValue)
 {
 int  v, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+stackIndex stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -802,7 +1209,7 @@ int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 int  _ClearVertexTypeInBicomp(graphP theGraph, int BicompRoot)
 {
 int  V, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+stackIndex stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -832,43 +1239,67 @@ void _ClearGraph(graphP theGraph)
 {
      if (theGraph->V != NULL)
      {
-          free(theGraph->V);
+          gp_FreeMemory(theGraph, theGraph->V);
           theGraph->V = NULL;
      }
      if (theGraph->VI != NULL)
      {
-          free(theGraph->VI);
-          theGraph->V = NULL;
+          gp_FreeMemory(theGraph, theGraph->VI);
+          theGraph->VI = NULL;
      }
      if (theGraph->E != NULL)
      {
-          free(theGraph->E);
-          theGraph->E = NULL;
+          gp_FreeMemory(theGraph, theGraph->E);
+          _SetEdgeColumns(theGraph, NULL, 0);
      }
 
      theGraph->N = 0;
      theGraph->NV = 0;
      theGraph->M = 0;
      theGraph->arcCapacity = 0;
+     theGraph->edgeHighWater = 0;
+     theGraph->vertexVisitedStamp = theGraph->edgeVisitedStamp = VISITED_STAMP_INCREMENT;
      theGraph->internalFlags = 0;
      theGraph->embedFlags = 0;
 
+     if (theGraph->arcMap != NULL)
+     {
+         gp_FreeMemory(theGraph, theGraph->arcMap);
+         theGraph->arcMap = NULL;
+     }
+     theGraph->numMappedPairs = 0;
+
      _InitIsolatorContext(theGraph);
+     gp_ClearEmbedStats(theGraph);
+     theGraph->fpPhaseObserver = NULL;
+     theGraph->phaseObserverContext = NULL;
+     gp_EnableTrace(theGraph, 0);
 
-     LCFree(&theGraph->BicompRootLists);
-     LCFree(&theGraph->sortedDFSChildLists);
+     gp_FreeListCollection(theGraph, &theGraph->BicompRootLists);
+     gp_FreeListCollection(theGraph, &theGraph->sortedDFSChildLists);
 
-     sp_Free(&theGraph->theStack);
+     gp_FreeStack(theGraph, &theGraph->theStack);
 
      if (theGraph->extFace != NULL)
      {
-         free(theGraph->extFace);
+         gp_FreeMemory(theGraph, theGraph->extFace);
          theGraph->extFace = NULL;
      }
+#ifdef VERTEX_HOTREC
+     if (theGraph->hotBlock != NULL)
+     {
+         gp_FreeMemory(theGraph, theGraph->hotBlock);
+         theGraph->hotBlock = NULL;
+         theGraph->H = NULL;
+     }
+#endif
 
-     sp_Free(&theGraph->edgeHoles);
+     gp_FreeStack(theGraph, &theGraph->edgeHoles);
 
      gp_FreeExtensions(theGraph);
+
+     // The extensions may have carved their arrays from the arena too
+     _FreeArena(theGraph);
 }
 
 /********************************************************************
@@ -879,12 +1310,16 @@ void _ClearGraph(graphP theGraph)
 
 void gp_Free(graphP *pGraph)
 {
+graphAllocator allocator;
+
      if (pGraph == NULL) return;
      if (*pGraph == NULL) return;
 
      _ClearGraph(*pGraph);
+     gp_SetArenaDirectory(*pGraph, NULL);
 
-     free(*pGraph);
+     allocator = (*pGraph)->allocator;
+     allocator.fpFree(allocator.context, *pGraph);
      *pGraph = NULL;
 }
 
@@ -932,6 +1367,7 @@ int  gp_CopyAdjacencyLists(graphP dstGraph, graphP srcGraph)
 	// Tell the dstGraph how many edges it now has and where the edge holes are
 	dstGraph->M = srcGraph->M;
     sp_Copy(dstGraph->edgeHoles, srcGraph->edgeHoles);
+    gp_UpdateEdgeHighWater(dstGraph);
 
 	return OK;
 }
@@ -942,6 +1378,11 @@ int  gp_CopyAdjacencyLists(graphP dstGraph, graphP srcGraph)
  must have been previously initialized with the same number of
  vertices as the srcGraph (e.g. gp_InitGraph(dstGraph, srcGraph->N).
 
+ Only the occupied prefix of each array is copied: the edge records
+ below the edge high water marks, the used part of each stack and, by
+ the extensions, the edge data below the high water mark that the
+ dstGraph receives before the extensions are copied.
+
  Returns OK for success, NOTOK for failure.
  ********************************************************************/
 
@@ -955,8 +1396,9 @@ int  v, e, Esize;
          return NOTOK;
      }
 
-     // The graphs need to be the same order and initialized
-     if (dstGraph->N != srcGraph->N || dstGraph->N == 0)
+     // The graphs need to be the same order and initialized, and the
+     // srcGraph must still have the working storage that is copied
+     if (dstGraph->N != srcGraph->N || dstGraph->N == 0 || gp_IsTrimmed(srcGraph))
      {
          return NOTOK;
      }
@@ -990,7 +1432,11 @@ int  v, e, Esize;
 
      // Copy the basic EdgeRec structures.  Augmentations to the edgeRec structure
      // created by extensions are copied below by gp_CopyExtensions()
-     Esize = gp_EdgeIndexBound(srcGraph);
+     // The edge records above both high water marks are in their initial
+     // state in both graphs, so they need not be copied
+     Esize = gp_EdgeTouchedIndexBound(srcGraph);
+     if (Esize < gp_EdgeTouchedIndexBound(dstGraph))
+    	 Esize = gp_EdgeTouchedIndexBound(dstGraph);
      for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
     	 gp_CopyEdgeRec(dstGraph, e, srcGraph, e);
 
@@ -998,6 +1444,9 @@ int  v, e, Esize;
      dstGraph->N = srcGraph->N;
      dstGraph->NV = srcGraph->NV;
      dstGraph->M = srcGraph->M;
+     dstGraph->edgeHighWater = srcGraph->edgeHighWater;
+     dstGraph->vertexVisitedStamp = srcGraph->vertexVisitedStamp;
+     dstGraph->edgeVisitedStamp = srcGraph->edgeVisitedStamp;
      dstGraph->internalFlags = srcGraph->internalFlags;
      dstGraph->embedFlags = srcGraph->embedFlags;
 
@@ -1009,7 +1458,9 @@ int  v, e, Esize;
      sp_Copy(dstGraph->edgeHoles, srcGraph->edgeHoles);
 
      // Copy the set of extensions, which includes copying the
-     // extension data as well as the function overload tables
+     // extension data as well as the function overload tables.
+     // This must be done after the edgeHighWater is copied above,
+     // since extensions only copy edge data below it
      if (gp_CopyExtensions(dstGraph, srcGraph) != OK)
     	 return NOTOK;
 
@@ -1032,13 +1483,25 @@ int  v, e, Esize;
 
 /********************************************************************
  gp_DupGraph()
+ Returns a new graph with the same allocator, allocation flags, embed
+ options, content and extensions as theGraph (see gp_CopyGraph()), or
+ NULL on failure.
  ********************************************************************/
 
 graphP gp_DupGraph(graphP theGraph)
 {
 graphP result;
 
-     if ((result = gp_New()) == NULL) return NULL;
+     if ((result = gp_NewWithAllocator(&theGraph->allocator)) == NULL) return NULL;
+
+     gp_SetAllocFlags(result, gp_GetAllocFlags(theGraph));
+     gp_SetEmbedOptions(result, gp_GetEmbedOptions(theGraph));
+
+     if (gp_SetArenaDirectory(result, theGraph->arena.dirName) != OK)
+     {
+         gp_Free(&result);
+         return NULL;
+     }
 
      if (gp_InitGraph(result, theGraph->N) != OK ||
          gp_CopyGraph(result, theGraph) != OK)
@@ -1235,7 +1698,7 @@ int N, arc, M, root, v, c, p, last, u, e, EsizeOccupied;
 
         else
 	    {
-            arc = 2*theGraph->M - 2;
+            arc = gp_GetFirstEdge(theGraph) + 2*theGraph->M - 2;
             gp_SetEdgeType(theGraph, arc, EDGE_TYPE_RANDOMTREE);
             gp_SetEdgeType(theGraph, gp_GetTwinArc(theGraph, arc), EDGE_TYPE_RANDOMTREE);
             gp_ClearEdgeVisited(theGraph, arc);
@@ -1247,7 +1710,7 @@ int N, arc, M, root, v, c, p, last, u, e, EsizeOccupied;
 
     M = numEdges <= 3*N - 6 ? numEdges : 3*N - 6;
 
-    root = 0;
+    root = gp_GetFirstVertex(theGraph);
     v = last = _getUnprocessedChild(theGraph, root);
 
     while (v != root && theGraph->M < M)
@@ -1328,7 +1791,7 @@ int N, arc, M, root, v, c, p, last, u, e, EsizeOccupied;
 /* Clear the edge types back to 'unknown' */
 
     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
-    for (e = 0; e < EsizeOccupied; e++)
+    for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e++)
     {
         gp_ClearEdgeType(theGraph, e);
         gp_ClearEdgeVisited(theGraph, e);
@@ -1642,6 +2105,7 @@ int  upos, vpos;
      gp_AttachArc(theGraph, v, NIL, vlink, vpos);
 
      theGraph->M++;
+     gp_UpdateEdgeHighWater(theGraph);
      return OK;
 }
 
@@ -1692,6 +2156,7 @@ int vertMax = gp_GetLastVirtualVertex(theGraph),
      gp_AttachArc(theGraph, v, e_v, e_vlink, vpos);
 
      theGraph->M++;
+     gp_UpdateEdgeHighWater(theGraph);
 
      return OK;
 }
@@ -1720,7 +2185,7 @@ int  gp_DeleteEdge(graphP theGraph, int e, int nextLink)
      // Clear the two edge records
      // (the bit twiddle (e & ~1) chooses the lesser of e and its twin arc)
 #if NIL == 0
-     memset(theGraph->E + (e & ~1), NIL_CHAR, sizeof(edgeRec) << 1);
+     _ClearEdgeRecords(theGraph, e & ~1, 2);
 #else
      _InitEdgeRec(theGraph, e);
      _InitEdgeRec(theGraph, gp_GetTwinArc(theGraph, e));
@@ -1864,7 +2329,7 @@ int e = gp_GetFirstArc(theGraph, vertex);
  Reverses the effects of _HideInternalEdges()
  ********************************************************************/
 
-int  _RestoreInternalEdges(graphP theGraph, int stackBottom)
+int  _RestoreInternalEdges(graphP theGraph, stackIndex stackBottom)
 {
 	return _RestoreHiddenEdges(theGraph, stackBottom);
 }
@@ -1880,7 +2345,7 @@ int  _RestoreInternalEdges(graphP theGraph, int stackBottom)
  Returns OK on success, NOTOK on internal failure.
  ********************************************************************/
 
-int  _RestoreHiddenEdges(graphP theGraph, int stackBottom)
+int  _RestoreHiddenEdges(graphP theGraph, stackIndex stackBottom)
 {
 	int  e;
 
@@ -2036,7 +2501,7 @@ int _IdentifyVertices(graphP theGraph, int u, int v, int eBefore)
 		// six more integers to indicate edges that were moved from
 		// v to u, so the "hidden edges stackBottom" is in the next
 		// position down.
-		int hiddenEdgesStackBottomIndex = sp_GetCurrentSize(theGraph->theStack)-7;
+		stackIndex hiddenEdgesStackBottomIndex = sp_GetCurrentSize(theGraph->theStack)-7;
 		int hiddenEdgesStackBottomValue = sp_Get(theGraph->theStack, hiddenEdgesStackBottomIndex);
 
 		sp_Set(theGraph->theStack, hiddenEdgesStackBottomIndex,	hiddenEdgesStackBottomValue - 1);
@@ -2385,7 +2850,7 @@ int  e, eTwin, u_orig, v_orig;
 int  _DeleteUnmarkedEdgesInBicomp(graphP theGraph, int BicompRoot)
 {
 int  V, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+stackIndex stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -2420,7 +2885,7 @@ int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 int  _ClearInvertedFlagsInBicomp(graphP theGraph, int BicompRoot)
 {
 int  V, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+stackIndex stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -2458,7 +2923,7 @@ int  _GetBicompSize(graphP theGraph, int BicompRoot)
 {
 int  V, e;
 int  theSize = 0;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+stackIndex stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -24,6 +24,8 @@ See the LICENSE.TXT file for licensing information.
  The function LCFree() deallocates the collection of lists and clears the
  pointer variable used to pass the collection.
 
+ LCGetMemoryUsage() returns the number of bytes allocated for a collection.
+
  An empty list is indicated by NIL.  To begin a list with node I, call
  LCPrepend() or LCAppend() with the NIL list and with I as the node.  The prev
  and next pointers in node I are set to I and I is returned as the head of
@@ -97,6 +99,34 @@ listCollectionP theListColl = NULL;
      return theListColl;
 }
 
+/*****************************************************************************
+ LCNewAt()
+ Constructs a list collection of N nodes in the LCSizeOf(N) bytes of memory
+ given by the caller, who remains its owner, so LCFree() must not be used.
+ *****************************************************************************/
+
+listCollectionP LCNewAt(void *memory, int N)
+{
+listCollectionP theListColl = (listCollectionP) memory;
+
+     if (N <= 0 || memory == NULL) return NULL;
+
+     theListColl->List = (lcnode *) (theListColl + 1);
+     theListColl->N = N;
+     LCReset(theListColl);
+
+     return theListColl;
+}
+
+/*****************************************************************************
+ LCSizeOf()
+ *****************************************************************************/
+
+size_t LCSizeOf(int N)
+{
+     return sizeof(listCollectionRec) + N * sizeof(lcnode);
+}
+
 /*****************************************************************************
  LCFree()
  *****************************************************************************/
@@ -112,6 +142,17 @@ void LCFree(listCollectionP *pListColl)
      *pListColl = NULL;
 }
 
+/*****************************************************************************
+ LCGetMemoryUsage()
+ *****************************************************************************/
+
+size_t LCGetMemoryUsage(listCollectionP listColl)
+{
+     if (listColl == NULL) return 0;
+
+     return sizeof(listCollectionRec) + listColl->N * sizeof(lcnode);
+}
+
 /*****************************************************************************
  LCInsertAfter()
  *****************************************************************************/
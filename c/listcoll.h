@@ -14,9 +14,12 @@ extern "C" {
 /* This include is needed for memset and memcpy */
 #include <string.h>
 
+/* This include is needed for graphIndex */
+#include "appconst.h"
+
 typedef struct
 {
-        int prev, next;
+        graphIndex prev, next;
 } lcnode;
 
 typedef struct
@@ -28,7 +31,10 @@ typedef struct
 typedef listCollectionRec * listCollectionP;
 
 listCollectionP LCNew(int N);
+listCollectionP LCNewAt(void *memory, int N);
+size_t LCSizeOf(int N);
 void LCFree(listCollectionP *pListColl);
+size_t LCGetMemoryUsage(listCollectionP listColl);
 
 void LCInsertAfter(listCollectionP listColl, int theAnchor, int theNewNode);
 void LCInsertBefore(listCollectionP listColl, int theAnchor, int theNewNode);
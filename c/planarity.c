@@ -119,7 +119,7 @@ int helpMessage(char *param)
 	else if (strcmp(param, "-menu") == 0)
 	{
 	    Message(
-	    	"'planarity -r [-q] C K N': Random graphs\n"
+	    	"'planarity -r [-q] C K N [-seed S] [-tail T O]': Random graphs\n"
 	    	"'planarity -s [-q] C I O [O2]': Specific graph\n"
 	        "'planarity -rm [-q] N O [O2]': Maximal planar random graph\n"
 	        "'planarity -rn [-q] N O [O2]': Nonplanar random graph (maximal planar + edge)\n"
@@ -134,6 +134,8 @@ int helpMessage(char *param)
 	    Message(
 	    	"K = # of graphs to randomly generate\n"
 	    	"N = # of vertices in each randomly generated graph\n"
+	    	"S = Random seed of the first graph (graph k uses S+k, default is the time)\n"
+	    	"T = # of slowest graphs to write to O, each also written to O.rank.txt\n"
 	        "I = Input file (for work on a specific graph)\n"
 	        "O = Primary output file\n"
 	        "    For example, if C=-p then O receives the planar embedding\n"
@@ -22,6 +22,7 @@ extern "C" {
 #include "graphK33Search.h"
 #include "graphK4Search.h"
 #include "graphDrawPlanar.h"
+#include "planarityAlgorithms.h"
 
 void ProjectTitle();
 int helpMessage(char *param);
@@ -30,6 +31,8 @@ int helpMessage(char *param);
 int SpecificGraph(char command, char *infileName, char *outfileName, char *outfile2Name);
 int RandomGraph(char command, int extraEdges, int numVertices, char *outfileName, char *outfile2Name);
 int RandomGraphs(char command, int, int);
+int RandomGraphsEx(char command, int NumGraphs, int SizeOfGraphs,
+				   unsigned int seed, int tailSize, char *tailFileName);
 
 int makeg_main(char command, int argc, char *argv[]);
 
@@ -38,7 +41,7 @@ int commandLine(int argc, char *argv[]);
 int legacyCommandLine(int argc, char *argv[]);
 int menu();
 
-char Mode,
+extern char Mode,
      OrigOut,
      EmbeddableOut,
      ObstructedOut,
@@ -49,7 +52,7 @@ void Reconfigure();
 
 /* Low-level Utilities */
 #define MAXLINE 1024
-char Line[MAXLINE];
+extern char Line[MAXLINE];
 
 void Message(char *message);
 void ErrorMessage(char *message);
@@ -60,10 +63,6 @@ void SaveAsciiGraph(graphP theGraph, char *filename);
 
 int  FilesEqual(char *file1Name, char *file2Name);
 
-int GetEmbedFlags(char command);
-char *GetAlgorithmName(char command);
-void AttachAlgorithm(graphP theGraph, char command);
-
 char *ConstructInputFilename(char *infileName);
 char *ConstructPrimaryOutputFilename(char *infileName, char *outfileName, char command);
 void WriteAlgorithmResults(graphP theGraph, int Result, char command, platform_time start, platform_time end, char *infileName);
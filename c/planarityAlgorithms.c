@@ -0,0 +1,74 @@
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+#include "planarityAlgorithms.h"
+#include "graphK23Search.h"
+#include "graphK33Search.h"
+#include "graphK4Search.h"
+#include "graphDrawPlanar.h"
+
+/****************************************************************************
+ GetEmbedFlags()
+ Returns the embedFlags of gp_Embed() for the command, or 0 if the command
+ does not select an algorithm.
+ ****************************************************************************/
+
+int  GetEmbedFlags(char command)
+{
+	int embedFlags = 0;
+
+	switch (command)
+	{
+		case 'o' : embedFlags = EMBEDFLAGS_OUTERPLANAR; break;
+		case 'p' : embedFlags = EMBEDFLAGS_PLANAR; break;
+		case 'd' : embedFlags = EMBEDFLAGS_DRAWPLANAR; break;
+		case '2' : embedFlags = EMBEDFLAGS_SEARCHFORK23; break;
+		case '3' : embedFlags = EMBEDFLAGS_SEARCHFORK33; break;
+		case '4' : embedFlags = EMBEDFLAGS_SEARCHFORK4; break;
+	}
+
+	return embedFlags;
+}
+
+/****************************************************************************
+ GetAlgorithmName()
+ ****************************************************************************/
+
+char *GetAlgorithmName(char command)
+{
+	char *algorithmName = "UnsupportedAlgorithm";
+
+	switch (command)
+	{
+		case 'p' : algorithmName = "PlanarEmbed"; break;
+		case 'd' : algorithmName = DRAWPLANAR_NAME;	break;
+		case 'o' : algorithmName = "OuterplanarEmbed"; break;
+		case '2' : algorithmName = K23SEARCH_NAME; break;
+		case '3' : algorithmName = K33SEARCH_NAME; break;
+		case '4' : algorithmName = K4SEARCH_NAME; break;
+	}
+
+	return algorithmName;
+}
+
+/****************************************************************************
+ AttachAlgorithm()
+ Attaches the graph extension that the command's algorithm needs, if any.
+ Returns OK, or NOTOK if the extension could not be attached.
+ ****************************************************************************/
+
+int  AttachAlgorithm(graphP theGraph, char command)
+{
+	switch (command)
+	{
+		case 'd' : return gp_AttachDrawPlanar(theGraph);
+		case '2' : return gp_AttachK23Search(theGraph);
+		case '3' : return gp_AttachK33Search(theGraph);
+		case '4' : return gp_AttachK4Search(theGraph);
+	}
+
+	return OK;
+}
@@ -0,0 +1,27 @@
+#ifndef PLANARITYALGORITHMS_H
+#define PLANARITYALGORITHMS_H
+
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "graph.h"
+
+/* The algorithms selected by the command characters p, d, o, 2, 3 and 4
+   of the planarity, planarity-bench and planarity-trace executables */
+
+int  GetEmbedFlags(char command);
+char *GetAlgorithmName(char command);
+int  AttachAlgorithm(graphP theGraph, char command);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
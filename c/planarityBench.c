@@ -0,0 +1,934 @@
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+/****************************************************************************
+ planarity-bench
+
+ Times gp_Embed() for each algorithm supported by the planarity command line
+ (p, d, o, 2, 3, 4) over a set of workload families and graph sizes, and
+ reports the median and 99th percentile nanoseconds per edge in JSON or CSV.
+
+ Each configuration runs a number of warm-up trials whose timings are
+ discarded, followed by the measured trials.  Trial t of a family and size
+ is generated from the seed (seed + t), so every algorithm and every build
+ is timed on exactly the same graphs.
+
+ Only the gp_Embed() call is timed; graph generation and reinitialization
+ are excluded, and so is the check of each measured result with
+ gp_TestEmbedResultIntegrity() that -verify adds, which fails the
+ configuration if a result is not a valid embedding or obstruction.  The
+ breakdown of the mean time per edge into the phases of gp_Embed() is
+ taken from gp_GetEmbedStats(), as are the hot path event counts per edge
+ when the library is built with EMBEDCOUNTERS.
+
+ With -hw, the hardware performance counters of planarityBenchCounters.c
+ are read at each phase boundary of gp_Embed() and reported per edge and
+ phase.  The reads add a little time to each measured trial.  If the
+ counters are unavailable, a note is written to stderr and the results
+ omit them.
+
+ The regression gate saves the results of a seeded corpus as a baseline
+ with -save FILE, and compares a later run of the same corpus to it with
+ -compare FILE (see planarityBenchBaseline.c).  planarity-bench exits
+ with BENCH_EXIT_REGRESSION if any configuration regressed in time per
+ edge or in its peak RSS, and with 1 on errors.  The peak RSS of each
+ configuration is its own high water mark where the platform can reset
+ the peak of the process (Linux), and that of the process so far
+ elsewhere.
+
+ Sizes up to MAX_DEFAULT_N (about 3.6 * 10^8) are accepted, which is the
+ largest N whose indices fit in the int graphIndex with the default edge
+ capacity.  That is a limit of the index arithmetic, not a tested size:
+ the largest graphs run so far have about 10^7 edges, for example with
+     planarity-bench -a p -f maxplanar -t 1 -w 0 -n 1000000,3000000
+ whose peak RSS is about 70 bytes per edge, so a run near the limit
+ (about 10^9 edges) would need a machine with about 80GB of memory.
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef WIN32
+#include <sys/resource.h>
+#endif
+
+#include "planarityBench.h"
+
+char *familyNames[NUM_FAMILIES] = {
+		"sparse", "maxplanar", "maxplanar+k", "tree", "dense"
+};
+
+char *phaseNames[NUMEMBEDPHASES] = {
+		"initialize", "edge_addition", "isolation", "postprocess", "extension_postprocess"
+};
+
+/****************************************************************************
+ MAIN
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	benchConfig config;
+	benchResult result;
+	hwCounters hw;
+	benchBaseline baseline;
+	FILE *outfile = stdout, *baselineFile = NULL;
+	int a, f, n, isFirst = 1, retVal = 0, numRegressions = 0;
+
+	if (bench_ParseArgs(&config, argc, argv) != OK)
+	{
+		bench_Usage();
+		return 1;
+	}
+
+	if (config.outfileName != NULL && (outfile = fopen(config.outfileName, WRITETEXT)) == NULL)
+	{
+		fprintf(stderr, "Unable to open '%s' for writing\n", config.outfileName);
+		return 1;
+	}
+
+	if (config.compareBaselineName != NULL &&
+		(bench_ReadBaseline(config.compareBaselineName, &baseline) != OK ||
+		 bench_CheckBaselineConfig(&config, &baseline) != OK))
+		return 1;
+
+	if (config.saveBaselineName != NULL)
+	{
+		if ((baselineFile = fopen(config.saveBaselineName, WRITETEXT)) == NULL)
+		{
+			fprintf(stderr, "Unable to open '%s' for writing\n", config.saveBaselineName);
+			return 1;
+		}
+		bench_WriteBaselineHeader(baselineFile, &config);
+	}
+
+	if (config.useHwCounters && bench_OpenHwCounters(&hw) == OK)
+		config.hw = &hw;
+
+	if (bench_ResetPeakRss() == OK)
+		config.resetsPeakRss = 1;
+	else
+		fprintf(stderr, "planarity-bench: the peak RSS cannot be reset, so the peak of "
+				"each configuration includes those run before it\n");
+
+	bench_WriteHeader(outfile, &config);
+
+	for (a = 0; config.algorithms[a] != '\0'; a++)
+	{
+		for (f = 0; f < NUM_FAMILIES; f++)
+		{
+			if (!config.families[f])
+				continue;
+
+			for (n = 0; n < config.numSizes; n++)
+			{
+				if (f == FAMILY_DENSE && config.sizes[n] > config.denseMaxN)
+					continue;
+
+				if (bench_RunConfiguration(&config, config.algorithms[a], f, config.sizes[n], &result) != OK)
+				{
+					fprintf(stderr, "Failed: algorithm=%c family=%s N=%d\n",
+							config.algorithms[a], familyNames[f], config.sizes[n]);
+					retVal = 1;
+					continue;
+				}
+
+				bench_WriteResult(outfile, &config, &result, isFirst);
+				isFirst = 0;
+				fflush(outfile);
+
+				if (baselineFile != NULL)
+					bench_WriteBaselineRecord(baselineFile, &result);
+
+				if (config.compareBaselineName != NULL &&
+					bench_CompareToBaseline(&config, &baseline, &result) != OK)
+					numRegressions++;
+			}
+		}
+	}
+
+	bench_WriteFooter(outfile, &config);
+
+	if (config.hw != NULL)
+		bench_CloseHwCounters(config.hw);
+
+	if (baselineFile != NULL)
+		fclose(baselineFile);
+
+	if (config.compareBaselineName != NULL)
+	{
+		fprintf(stderr, "%d regression(s) against baseline '%s'\n",
+				numRegressions, config.compareBaselineName);
+		bench_FreeBaseline(&baseline);
+
+		if (numRegressions > 0 && retVal == 0)
+			retVal = BENCH_EXIT_REGRESSION;
+	}
+
+	if (outfile != stdout)
+		fclose(outfile);
+
+	return retVal;
+}
+
+/****************************************************************************
+ bench_Usage()
+ ****************************************************************************/
+
+void bench_Usage(void)
+{
+	fprintf(stderr,
+		"Usage: planarity-bench [options]\n"
+		"  -a ALGS     algorithms to run, any of 'pdo234' (default pdo234)\n"
+		"  -f FAMS     comma separated families: sparse,maxplanar,maxplanar+k,tree,dense\n"
+		"              or 'all' (default all)\n"
+		"  -n SIZES    comma separated vertex counts (default 1000,10000,100000)\n"
+		"  -t TRIALS   measured trials per configuration (default 21)\n"
+		"  -w WARMUP   discarded warm-up trials per configuration (default 3)\n"
+		"  -k EXTRA    edges added to maximal planar graphs by maxplanar+k (default 10)\n"
+		"  -D MAXN     largest N used for the dense family (default 1000)\n"
+		"  -s SEED     base random seed (default 1)\n"
+		"  -csv        write CSV instead of JSON\n"
+		"  -hw         also report hardware performance counters per edge and phase\n"
+		"  -alloc MODE allocate each graph's arrays 'separate' (default), from one\n"
+		"              'arena', from an arena on 'hugepages', or from an arena\n"
+		"              mapped from a 'file' in $TMPDIR or /var/tmp\n"
+		"  -compact    compact the arcs of each graph after its DFS (EMBEDOPTIONS_COMPACTARCS)\n"
+		"  -verify     test the integrity of the result of each measured trial\n"
+		"  -o FILE     write results to FILE instead of stdout\n"
+		"  -save FILE  save the results as a performance baseline in FILE\n"
+		"  -compare FILE\n"
+		"              compare the results to the baseline in FILE and exit with\n"
+		"              status 2 if any configuration regressed\n"
+		"  -tol PCT    time per edge tolerance of -compare in percent (default 10)\n"
+		"  -memtol PCT peak RSS tolerance of -compare in percent (default 10)\n");
+}
+
+/****************************************************************************
+ bench_ParseArgs()
+ ****************************************************************************/
+
+int  bench_ParseArgs(benchConfig *config, int argc, char *argv[])
+{
+	int i;
+
+	memset(config, 0, sizeof(benchConfig));
+	strcpy(config->algorithms, "pdo234");
+	bench_ParseFamilies(config, "all");
+	bench_ParseSizes(config, "1000,10000,100000");
+	config->trials = 21;
+	config->warmup = 3;
+	config->extraEdges = 10;
+	config->denseMaxN = 1000;
+	config->seed = 1;
+	config->timeTolerance = 10.0;
+	config->memTolerance = 10.0;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-csv") == 0)
+			config->csv = 1;
+
+		else if (strcmp(argv[i], "-hw") == 0)
+			config->useHwCounters = 1;
+		else if (strcmp(argv[i], "-compact") == 0)
+			config->embedOptions |= EMBEDOPTIONS_COMPACTARCS;
+		else if (strcmp(argv[i], "-verify") == 0)
+			config->verify = 1;
+
+		else if (i+1 >= argc)
+			return NOTOK;
+
+		else if (strcmp(argv[i], "-a") == 0)
+		{
+			if (strlen(argv[++i]) >= sizeof(config->algorithms) ||
+				strspn(argv[i], "pdo234") != strlen(argv[i]))
+				return NOTOK;
+			strcpy(config->algorithms, argv[i]);
+		}
+		else if (strcmp(argv[i], "-f") == 0)
+		{
+			if (bench_ParseFamilies(config, argv[++i]) != OK)
+				return NOTOK;
+		}
+		else if (strcmp(argv[i], "-n") == 0)
+		{
+			if (bench_ParseSizes(config, argv[++i]) != OK)
+				return NOTOK;
+		}
+		else if (strcmp(argv[i], "-t") == 0)
+			config->trials = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-w") == 0)
+			config->warmup = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-k") == 0)
+			config->extraEdges = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-D") == 0)
+			config->denseMaxN = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-s") == 0)
+			config->seed = (unsigned int) strtoul(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "-o") == 0)
+			config->outfileName = argv[++i];
+		else if (strcmp(argv[i], "-alloc") == 0)
+		{
+			i++;
+			if (strcmp(argv[i], "separate") == 0)
+				config->allocFlags = 0;
+			else if (strcmp(argv[i], "arena") == 0)
+				config->allocFlags = ALLOCFLAGS_ARENA;
+			else if (strcmp(argv[i], "hugepages") == 0)
+				config->allocFlags = ALLOCFLAGS_HUGEPAGES;
+			else if (strcmp(argv[i], "file") == 0)
+				config->allocFlags = ALLOCFLAGS_FILEBACKED;
+			else
+				return NOTOK;
+		}
+		else if (strcmp(argv[i], "-save") == 0)
+			config->saveBaselineName = argv[++i];
+		else if (strcmp(argv[i], "-compare") == 0)
+			config->compareBaselineName = argv[++i];
+		else if (strcmp(argv[i], "-tol") == 0)
+			config->timeTolerance = atof(argv[++i]);
+		else if (strcmp(argv[i], "-memtol") == 0)
+			config->memTolerance = atof(argv[++i]);
+		else
+			return NOTOK;
+	}
+
+	if (config->trials < 1 || config->warmup < 0 || config->extraEdges < 0 ||
+		config->timeTolerance < 0 || config->memTolerance < 0)
+		return NOTOK;
+
+	return OK;
+}
+
+/****************************************************************************
+ bench_ParseSizes()
+ ****************************************************************************/
+
+int  bench_ParseSizes(benchConfig *config, char *sizeList)
+{
+	char *p = sizeList, *end;
+	long N;
+
+	config->numSizes = 0;
+	while (*p != '\0')
+	{
+		N = strtol(p, &end, 10);
+		if (end == p || N < 6 || N > MAX_DEFAULT_N || config->numSizes >= MAXSIZES)
+			return NOTOK;
+
+		config->sizes[config->numSizes++] = (int) N;
+
+		p = end;
+		if (*p == ',')
+			p++;
+		else if (*p != '\0')
+			return NOTOK;
+	}
+
+	return config->numSizes > 0 ? OK : NOTOK;
+}
+
+/****************************************************************************
+ bench_ParseFamilies()
+ ****************************************************************************/
+
+int  bench_ParseFamilies(benchConfig *config, char *familyList)
+{
+	char *p = familyList;
+	int f, len, found;
+
+	for (f = 0; f < NUM_FAMILIES; f++)
+		config->families[f] = strcmp(familyList, "all") == 0 ? 1 : 0;
+
+	if (strcmp(familyList, "all") == 0)
+		return OK;
+
+	while (*p != '\0')
+	{
+		len = (int) strcspn(p, ",");
+		found = 0;
+		for (f = 0; f < NUM_FAMILIES; f++)
+		{
+			if ((int) strlen(familyNames[f]) == len && strncmp(p, familyNames[f], len) == 0)
+			{
+				config->families[f] = found = 1;
+				break;
+			}
+		}
+
+		if (!found)
+			return NOTOK;
+
+		p += len;
+		if (*p == ',')
+			p++;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ bench_GetFamily()
+ Returns the FAMILY_ value with the given name, or -1 if there is none.
+ ****************************************************************************/
+
+int  bench_GetFamily(char *familyName)
+{
+	int f;
+
+	for (f = 0; f < NUM_FAMILIES; f++)
+	{
+		if (strcmp(familyName, familyNames[f]) == 0)
+			return f;
+	}
+
+	return -1;
+}
+
+/****************************************************************************
+ bench_RunConfiguration()
+ Runs the warm-up and measured trials of one configuration and summarizes
+ the measured nanoseconds per edge into the result.
+ ****************************************************************************/
+
+int  bench_RunConfiguration(benchConfig *config, char command, int family, int N, benchResult *result)
+{
+	graphP theGraph, origGraph = NULL;
+	double *samples, start, end, totalM = 0, totalNsPerEdge = 0;
+	int trial, numTrials = config->warmup + config->trials, M, Result;
+	int embedFlags = GetEmbedFlags(command);
+
+	memset(result, 0, sizeof(benchResult));
+	result->command = command;
+	result->family = family;
+	result->N = N;
+	result->trials = config->trials;
+
+	// The peak RSS of the configuration covers its graph and all of its trials
+	if (config->resetsPeakRss)
+		bench_ResetPeakRss();
+
+	if ((samples = (double *) malloc(config->trials * sizeof(double))) == NULL)
+		return NOTOK;
+
+	if ((theGraph = bench_MakeGraph(command, family, N, config->extraEdges, config->allocFlags)) == NULL)
+	{
+		free(samples);
+		return NOTOK;
+	}
+	gp_SetEmbedOptions(theGraph, config->embedOptions);
+
+	if (config->hw != NULL)
+		gp_SetEmbedPhaseObserver(theGraph, bench_ObserveEmbedPhase, config->hw);
+
+	gp_GetMemoryUsage(theGraph, &result->memory);
+
+	for (trial = 0; trial < numTrials; trial++)
+	{
+		srand(config->seed + trial);
+
+		if (bench_CreateGraph(theGraph, family, config->extraEdges) != OK)
+		{
+			gp_Free(&theGraph);
+			free(samples);
+			return NOTOK;
+		}
+
+		M = theGraph->M;
+
+		// The copy that -verify tests the result against is made untimed
+		if (config->verify && trial >= config->warmup &&
+			(origGraph = gp_DupGraph(theGraph)) == NULL)
+		{
+			gp_Free(&theGraph);
+			free(samples);
+			return NOTOK;
+		}
+
+		// The phase timings accumulate over the measured trials only
+		if (trial == config->warmup)
+		{
+			gp_ClearEmbedStats(theGraph);
+			if (config->hw != NULL)
+				bench_ClearHwCounters(config->hw);
+		}
+
+		start = bench_GetTimeNs();
+		Result = gp_Embed(theGraph, embedFlags);
+		end = bench_GetTimeNs();
+
+		if (origGraph != NULL)
+		{
+			if (Result != NOTOK && gp_TestEmbedResultIntegrity(theGraph, origGraph, Result) != Result)
+				Result = NOTOK;
+			gp_Free(&origGraph);
+		}
+
+		if (trial >= config->warmup)
+		{
+			samples[trial - config->warmup] = (end - start) / (M > 0 ? M : 1);
+			totalNsPerEdge += samples[trial - config->warmup];
+			totalM += M;
+
+			if (Result == OK)
+				result->numOK++;
+			else if (Result == NONEMBEDDABLE)
+				result->numNonembeddable++;
+			else
+				result->numNotOK++;
+		}
+
+		gp_ReinitializeGraph(theGraph);
+	}
+
+	qsort(samples, config->trials, sizeof(double), bench_CompareDoubles);
+
+	result->M = totalM / config->trials;
+	result->medianNsPerEdge = bench_Percentile(samples, config->trials, 50.0);
+	result->p99NsPerEdge = bench_Percentile(samples, config->trials, 99.0);
+	result->meanNsPerEdge = totalNsPerEdge / config->trials;
+	result->minNsPerEdge = samples[0];
+	result->madNsPerEdge = bench_MedianAbsoluteDeviation(samples, config->trials, result->medianNsPerEdge);
+	result->peakRssKB = bench_GetPeakRssKB();
+	gp_GetEmbedStats(theGraph, &result->phases);
+	if (config->hw != NULL)
+		memcpy(result->hw, config->hw->phaseTotals, sizeof(result->hw));
+
+	gp_Free(&theGraph);
+	free(samples);
+
+	return result->numNotOK == 0 ? OK : NOTOK;
+}
+
+/****************************************************************************
+ bench_MakeGraph()
+ Makes a graph with enough arc capacity for the largest graph the family
+ generates on N vertices, allocated as selected by allocFlags, then attaches
+ the algorithm for the command.
+ ****************************************************************************/
+
+graphP bench_MakeGraph(char command, int family, int N, int extraEdges, int allocFlags)
+{
+	graphP theGraph;
+
+	if ((theGraph = gp_New()) == NULL ||
+		gp_SetAllocFlags(theGraph, allocFlags) != OK ||
+		gp_EnsureArcCapacity(theGraph, bench_GetArcCapacity(family, N, extraEdges)) != OK ||
+		gp_InitGraph(theGraph, N) != OK ||
+		AttachAlgorithm(theGraph, command) != OK)
+	{
+		gp_Free(&theGraph);
+		return NULL;
+	}
+
+	return theGraph;
+}
+
+/****************************************************************************
+ bench_GetArcCapacity()
+ ****************************************************************************/
+
+int  bench_GetArcCapacity(int family, int N, int extraEdges)
+{
+	switch (family)
+	{
+		case FAMILY_MAXPLANARPLUSK : return 2 * (3*N - 6 + extraEdges);
+		case FAMILY_DENSE          : return N * (N-1);
+	}
+
+	return 2 * (3*N - 6);
+}
+
+/****************************************************************************
+ bench_CreateGraph()
+ Generates the next graph of the family using the current random seed.
+
+ sparse      - a random tree plus N/2 random edges (average degree 3)
+ maxplanar   - a random maximal planar graph (3N-6 edges)
+ maxplanar+k - a random maximal planar graph plus k random edges
+ tree        - a random tree (N-1 edges)
+ dense       - a complete graph less a random tenth of its edges
+ ****************************************************************************/
+
+int  bench_CreateGraph(graphP theGraph, int family, int extraEdges)
+{
+	int N = theGraph->N;
+
+	switch (family)
+	{
+		case FAMILY_SPARSE         : return bench_CreateRandomSparseGraph(theGraph);
+		case FAMILY_MAXPLANAR      : return gp_CreateRandomGraphEx(theGraph, 3*N - 6);
+		case FAMILY_MAXPLANARPLUSK : return gp_CreateRandomGraphEx(theGraph, 3*N - 6 + extraEdges);
+		case FAMILY_TREE           : return gp_CreateRandomGraphEx(theGraph, N - 1);
+		case FAMILY_DENSE          : return bench_CreateDenseGraph(theGraph);
+	}
+
+	return NOTOK;
+}
+
+/****************************************************************************
+ bench_CreateRandomSparseGraph()
+ ****************************************************************************/
+
+int  bench_CreateRandomSparseGraph(graphP theGraph)
+{
+	int N = theGraph->N, M = N - 1 + N/2, u, v;
+	int first = gp_GetFirstVertex(theGraph), last = gp_GetLastVertex(theGraph);
+
+	for (v = first + 1; v <= last; v++)
+	{
+		u = first + rand() % (v - first);
+		if (gp_AddEdge(theGraph, u, 0, v, 0) != OK)
+			return NOTOK;
+	}
+
+	while (theGraph->M < M)
+	{
+		u = first + rand() % N;
+		v = first + rand() % N;
+
+		if (u != v && !gp_IsNeighbor(theGraph, u, v))
+		{
+			if (gp_AddEdge(theGraph, u, 0, v, 0) != OK)
+				return NOTOK;
+		}
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ bench_CreateDenseGraph()
+ ****************************************************************************/
+
+int  bench_CreateDenseGraph(graphP theGraph)
+{
+	int u, v;
+
+	for (u = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, u); u++)
+	{
+		for (v = u + 1; gp_VertexInRange(theGraph, v); v++)
+		{
+			if (rand() % 10 == 0)
+				continue;
+
+			if (gp_AddEdge(theGraph, u, 0, v, 0) != OK)
+				return NOTOK;
+		}
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ bench_GetTimeNs()
+ Returns a monotonic time stamp in nanoseconds.
+ ****************************************************************************/
+
+double bench_GetTimeNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+/****************************************************************************
+ bench_GetPeakRssKB()
+ Returns the peak resident set size of the process in kilobytes since it
+ started or since the last bench_ResetPeakRss(), or 0 if the platform does
+ not report it.  On Linux the peak is the VmHWM of /proc/self/status,
+ because the ru_maxrss of getrusage() is not reset by bench_ResetPeakRss().
+ ****************************************************************************/
+
+long bench_GetPeakRssKB(void)
+{
+#ifndef WIN32
+	struct rusage usage;
+#endif
+#ifdef __linux__
+	FILE *status;
+	char line[128];
+	long peakKB = -1;
+
+	if ((status = fopen("/proc/self/status", "r")) != NULL)
+	{
+		while (peakKB < 0 && fgets(line, sizeof(line), status) != NULL)
+		{
+			if (sscanf(line, "VmHWM: %ld", &peakKB) != 1)
+				peakKB = -1;
+		}
+		fclose(status);
+
+		if (peakKB >= 0)
+			return peakKB;
+	}
+#endif
+#ifndef WIN32
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+#ifdef __APPLE__
+		return (long) (usage.ru_maxrss / 1024);
+#else
+		return (long) usage.ru_maxrss;
+#endif
+#endif
+
+	return 0;
+}
+
+/****************************************************************************
+ bench_ResetPeakRss()
+ Resets the peak resident set size of the process to its current resident
+ set size, which Linux does when 5 is written to /proc/self/clear_refs.
+ Returns OK if the peak was reset, NOTOK if the platform cannot reset it.
+ ****************************************************************************/
+
+int  bench_ResetPeakRss(void)
+{
+#ifdef __linux__
+	FILE *clearRefs;
+	int written;
+
+	if ((clearRefs = fopen("/proc/self/clear_refs", "w")) != NULL)
+	{
+		written = fputs("5", clearRefs) >= 0;
+		if (fclose(clearRefs) == 0 && written)
+			return OK;
+	}
+#endif
+
+	return NOTOK;
+}
+
+/****************************************************************************
+ bench_CompareDoubles()
+ ****************************************************************************/
+
+int  bench_CompareDoubles(const void *a, const void *b)
+{
+	double x = *(const double *) a, y = *(const double *) b;
+
+	return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/****************************************************************************
+ bench_Percentile()
+ Nearest-rank percentile of an ascending array of samples.
+ ****************************************************************************/
+
+double bench_Percentile(double *sortedSamples, int numSamples, double percentile)
+{
+	int rank = (int) (percentile / 100.0 * numSamples + 0.999999);
+
+	rank = rank < 1 ? 1 : (rank > numSamples ? numSamples : rank);
+	return sortedSamples[rank - 1];
+}
+
+/****************************************************************************
+ bench_MedianAbsoluteDeviation()
+ The median of the absolute deviations of the samples from their median,
+ a measure of the noise of a configuration that is robust to outliers.
+ ****************************************************************************/
+
+double bench_MedianAbsoluteDeviation(double *sortedSamples, int numSamples, double median)
+{
+	double *deviations, mad;
+	int i;
+
+	if ((deviations = (double *) malloc(numSamples * sizeof(double))) == NULL)
+		return 0.0;
+
+	for (i = 0; i < numSamples; i++)
+		deviations[i] = sortedSamples[i] > median ? sortedSamples[i] - median : median - sortedSamples[i];
+
+	qsort(deviations, numSamples, sizeof(double), bench_CompareDoubles);
+	mad = bench_Percentile(deviations, numSamples, 50.0);
+
+	free(deviations);
+	return mad;
+}
+
+/****************************************************************************
+ bench_PerEdge()
+ Mean amount per edge of a phase time or event count accumulated over the
+ measured trials.
+ ****************************************************************************/
+
+double bench_PerEdge(benchResult *result, unsigned long long total)
+{
+	double totalM = result->M * result->trials;
+
+	return totalM > 0 ? (double) total / totalM : 0.0;
+}
+
+/****************************************************************************
+ bench_WriteHeader()
+ bench_WriteResult()
+ bench_WriteFooter()
+ ****************************************************************************/
+
+void bench_WriteHeader(FILE *outfile, benchConfig *config)
+{
+	if (config->csv)
+	{
+		fprintf(outfile, "algorithm,command,family,N,M,trials,warmup,seed,"
+				"median_ns_per_edge,p99_ns_per_edge,mean_ns_per_edge,min_ns_per_edge,"
+				"mad_ns_per_edge,peak_rss_kb,graph_bytes,num_ok,num_nonembeddable,initialize_ns_per_edge,edge_addition_ns_per_edge,"
+				"isolation_ns_per_edge,postprocess_ns_per_edge,extension_postprocess_ns_per_edge");
+#ifdef EMBEDCOUNTERS
+		fprintf(outfile, ",walkup_hops_per_edge,walkdown_iterations_per_edge,"
+				"merge_bicomps_calls_per_edge,invert_vertex_flips_per_edge,"
+				"inactive_vertex_hops_per_edge,future_pertinent_child_advances_per_edge,"
+				"blocked_bicomp_reentries_per_edge");
+#endif
+		bench_WriteHwHeader(outfile, config);
+		fprintf(outfile, "\n");
+	}
+	else
+	{
+		fprintf(outfile, "{\n  \"benchmark\": \"planarity-bench\",\n");
+		fprintf(outfile, "  \"trials\": %d,\n  \"warmup\": %d,\n  \"seed\": %u,\n",
+				config->trials, config->warmup, config->seed);
+		fprintf(outfile, "  \"results\": [");
+	}
+}
+
+void bench_WriteResult(FILE *outfile, benchConfig *config, benchResult *result, int isFirst)
+{
+	if (config->csv)
+	{
+		fprintf(outfile, "%s,%c,%s,%d,%.0f,%d,%d,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%ld,%lu,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f",
+				GetAlgorithmName(result->command), result->command,
+				familyNames[result->family], result->N, result->M,
+				result->trials, config->warmup, config->seed,
+				result->medianNsPerEdge, result->p99NsPerEdge,
+				result->meanNsPerEdge, result->minNsPerEdge,
+				result->madNsPerEdge, result->peakRssKB, (unsigned long) result->memory.total,
+				result->numOK, result->numNonembeddable,
+				bench_PerEdge(result, result->phases.initializeTime),
+				bench_PerEdge(result, result->phases.edgeAdditionTime),
+				bench_PerEdge(result, result->phases.isolationTime),
+				bench_PerEdge(result, result->phases.postprocessTime),
+				bench_PerEdge(result, result->phases.extensionPostprocessTime));
+#ifdef EMBEDCOUNTERS
+		fprintf(outfile, ",%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f",
+				bench_PerEdge(result, result->phases.counters.walkUpHops),
+				bench_PerEdge(result, result->phases.counters.walkDownIterations),
+				bench_PerEdge(result, result->phases.counters.mergeBicompsCalls),
+				bench_PerEdge(result, result->phases.counters.invertVertexFlips),
+				bench_PerEdge(result, result->phases.counters.inactiveVertexHops),
+				bench_PerEdge(result, result->phases.counters.futurePertinentChildAdvances),
+				bench_PerEdge(result, result->phases.counters.blockedBicompReentries));
+#endif
+		bench_WriteHwResult(outfile, config, result);
+		fprintf(outfile, "\n");
+	}
+	else
+	{
+		fprintf(outfile, "%s\n    {\"algorithm\": \"%s\", \"command\": \"%c\", \"family\": \"%s\", "
+				"\"N\": %d, \"M\": %.0f, \"trials\": %d, "
+				"\"median_ns_per_edge\": %.3f, \"p99_ns_per_edge\": %.3f, "
+				"\"mean_ns_per_edge\": %.3f, \"min_ns_per_edge\": %.3f, "
+				"\"mad_ns_per_edge\": %.3f, \"peak_rss_kb\": %ld, \"graph_bytes\": %lu, "
+				"\"num_ok\": %d, \"num_nonembeddable\": %d, "
+				"\"phases_ns_per_edge\": {\"initialize\": %.3f, \"edge_addition\": %.3f, "
+				"\"isolation\": %.3f, \"postprocess\": %.3f, \"extension_postprocess\": %.3f}",
+				isFirst ? "" : ",",
+				GetAlgorithmName(result->command), result->command,
+				familyNames[result->family], result->N, result->M, result->trials,
+				result->medianNsPerEdge, result->p99NsPerEdge,
+				result->meanNsPerEdge, result->minNsPerEdge,
+				result->madNsPerEdge, result->peakRssKB, (unsigned long) result->memory.total,
+				result->numOK, result->numNonembeddable,
+				bench_PerEdge(result, result->phases.initializeTime),
+				bench_PerEdge(result, result->phases.edgeAdditionTime),
+				bench_PerEdge(result, result->phases.isolationTime),
+				bench_PerEdge(result, result->phases.postprocessTime),
+				bench_PerEdge(result, result->phases.extensionPostprocessTime));
+
+#ifdef EMBEDCOUNTERS
+		fprintf(outfile, ", \"counters_per_edge\": {\"walkup_hops\": %.3f, \"walkdown_iterations\": %.3f, "
+				"\"merge_bicomps_calls\": %.3f, \"invert_vertex_flips\": %.3f, "
+				"\"inactive_vertex_hops\": %.3f, \"future_pertinent_child_advances\": %.3f, "
+				"\"blocked_bicomp_reentries\": %.3f}",
+				bench_PerEdge(result, result->phases.counters.walkUpHops),
+				bench_PerEdge(result, result->phases.counters.walkDownIterations),
+				bench_PerEdge(result, result->phases.counters.mergeBicompsCalls),
+				bench_PerEdge(result, result->phases.counters.invertVertexFlips),
+				bench_PerEdge(result, result->phases.counters.inactiveVertexHops),
+				bench_PerEdge(result, result->phases.counters.futurePertinentChildAdvances),
+				bench_PerEdge(result, result->phases.counters.blockedBicompReentries));
+#endif
+
+		bench_WriteHwResult(outfile, config, result);
+		fprintf(outfile, "}");
+	}
+}
+
+void bench_WriteFooter(FILE *outfile, benchConfig *config)
+{
+	if (!config->csv)
+		fprintf(outfile, "\n  ]\n}\n");
+}
+
+/****************************************************************************
+ bench_WriteHwHeader()
+ bench_WriteHwResult()
+ Write the hardware event counts per edge of each phase when -hw is in
+ effect, as CSV columns or as a JSON object.  The counts of events that
+ could not be opened are written as empty columns or null.
+ ****************************************************************************/
+
+void bench_WriteHwHeader(FILE *outfile, benchConfig *config)
+{
+	int phase, event;
+
+	if (config->hw == NULL || !config->csv)
+		return;
+
+	for (phase = 0; phase < NUMEMBEDPHASES; phase++)
+		for (event = 0; event < NUM_HWEVENTS; event++)
+			fprintf(outfile, ",%s_%s_per_edge", phaseNames[phase], hwEventNames[event]);
+}
+
+void bench_WriteHwResult(FILE *outfile, benchConfig *config, benchResult *result)
+{
+	int phase, event;
+
+	if (config->hw == NULL)
+		return;
+
+	if (!config->csv)
+		fprintf(outfile, ", \"hw_per_edge\": {");
+
+	for (phase = 0; phase < NUMEMBEDPHASES; phase++)
+	{
+		if (!config->csv)
+			fprintf(outfile, "%s\"%s\": {", phase > 0 ? ", " : "", phaseNames[phase]);
+
+		for (event = 0; event < NUM_HWEVENTS; event++)
+		{
+			if (config->csv)
+				fprintf(outfile, ",");
+			else
+				fprintf(outfile, "%s\"%s\": ", event > 0 ? ", " : "", hwEventNames[event]);
+
+			if (config->hw->fd[event] >= 0)
+				fprintf(outfile, "%.3f", bench_PerEdge(result, result->hw[phase][event]));
+			else if (!config->csv)
+				fprintf(outfile, "null");
+		}
+
+		if (!config->csv)
+			fprintf(outfile, "}");
+	}
+
+	if (!config->csv)
+		fprintf(outfile, "}");
+}
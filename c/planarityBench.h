@@ -0,0 +1,154 @@
+#ifndef PLANARITYBENCH_H
+#define PLANARITYBENCH_H
+
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+
+#include "graph.h"
+#include "graphK23Search.h"
+#include "graphK33Search.h"
+#include "graphK4Search.h"
+#include "graphDrawPlanar.h"
+#include "planarityBenchCounters.h"
+#include "planarityAlgorithms.h"
+
+/* Workload families */
+
+#define FAMILY_SPARSE           0
+#define FAMILY_MAXPLANAR        1
+#define FAMILY_MAXPLANARPLUSK   2
+#define FAMILY_TREE             3
+#define FAMILY_DENSE            4
+#define NUM_FAMILIES            5
+
+extern char *familyNames[NUM_FAMILIES];
+
+/* Names of the phases of gp_Embed() in the results, by EMBEDPHASE_ value */
+
+extern char *phaseNames[NUMEMBEDPHASES];
+
+/* Exit code of planarity-bench when -compare finds a regression */
+
+#define BENCH_EXIT_REGRESSION   2
+
+/* One configuration of a baseline file (see planarityBenchBaseline.c) */
+
+typedef struct
+{
+	char command;
+	int  family;
+	int  N;
+	double medianNsPerEdge;
+	double madNsPerEdge;
+	long peakRssKB;
+} benchBaselineRecord;
+
+typedef struct
+{
+	int  trials;
+	int  warmup;
+	int  extraEdges;
+	unsigned int seed;
+	int  numRecords, capacity;
+	benchBaselineRecord *records;
+} benchBaseline;
+
+/* Benchmark configuration */
+
+#define MAXSIZES        32
+
+typedef struct
+{
+	char algorithms[16];
+	int  families[NUM_FAMILIES];
+	int  sizes[MAXSIZES];
+	int  numSizes;
+	int  trials;
+	int  warmup;
+	int  extraEdges;
+	int  denseMaxN;
+	unsigned int seed;
+	int  csv;
+	char *outfileName;
+	int  useHwCounters;
+	hwCounters *hw;
+	int  resetsPeakRss;
+	int  allocFlags;
+	int  embedOptions;
+	int  verify;
+	char *saveBaselineName;
+	char *compareBaselineName;
+	double timeTolerance;
+	double memTolerance;
+} benchConfig;
+
+/* The measured results of one (algorithm, family, N) configuration */
+
+typedef struct
+{
+	char command;
+	int  family;
+	int  N;
+	int  trials;
+	double M;
+	double medianNsPerEdge;
+	double p99NsPerEdge;
+	double meanNsPerEdge;
+	double minNsPerEdge;
+	double madNsPerEdge;
+	long peakRssKB;
+	graphMemoryUsage memory;
+	int  numOK, numNonembeddable, numNotOK;
+	embedStats phases;
+	unsigned long long hw[NUMEMBEDPHASES][NUM_HWEVENTS];
+} benchResult;
+
+int  bench_ParseArgs(benchConfig *config, int argc, char *argv[]);
+int  bench_ParseSizes(benchConfig *config, char *sizeList);
+int  bench_ParseFamilies(benchConfig *config, char *familyList);
+int  bench_GetFamily(char *familyName);
+void bench_Usage(void);
+
+int  bench_RunConfiguration(benchConfig *config, char command, int family, int N, benchResult *result);
+graphP bench_MakeGraph(char command, int family, int N, int extraEdges, int allocFlags);
+int  bench_GetArcCapacity(int family, int N, int extraEdges);
+int  bench_CreateGraph(graphP theGraph, int family, int extraEdges);
+int  bench_CreateRandomSparseGraph(graphP theGraph);
+int  bench_CreateDenseGraph(graphP theGraph);
+
+
+double bench_GetTimeNs(void);
+long bench_GetPeakRssKB(void);
+int  bench_ResetPeakRss(void);
+int  bench_CompareDoubles(const void *a, const void *b);
+double bench_Percentile(double *sortedSamples, int numSamples, double percentile);
+double bench_MedianAbsoluteDeviation(double *sortedSamples, int numSamples, double median);
+
+double bench_PerEdge(benchResult *result, unsigned long long total);
+void bench_WriteHeader(FILE *outfile, benchConfig *config);
+void bench_WriteResult(FILE *outfile, benchConfig *config, benchResult *result, int isFirst);
+void bench_WriteFooter(FILE *outfile, benchConfig *config);
+void bench_WriteHwHeader(FILE *outfile, benchConfig *config);
+void bench_WriteHwResult(FILE *outfile, benchConfig *config, benchResult *result);
+
+int  bench_ReadBaseline(char *fileName, benchBaseline *baseline);
+void bench_FreeBaseline(benchBaseline *baseline);
+void bench_WriteBaselineHeader(FILE *baselineFile, benchConfig *config);
+void bench_WriteBaselineRecord(FILE *baselineFile, benchResult *result);
+int  bench_CheckBaselineConfig(benchConfig *config, benchBaseline *baseline);
+int  bench_CompareToBaseline(benchConfig *config, benchBaseline *baseline, benchResult *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
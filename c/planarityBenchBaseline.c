@@ -0,0 +1,261 @@
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+/****************************************************************************
+ Performance baselines for planarity-bench
+
+ planarity-bench -save FILE records the median and the median absolute
+ deviation (MAD) of the nanoseconds per edge of each configuration, and
+ the peak resident set size (RSS) of the configuration.  A later run with
+ -compare FILE on the same seeded corpus reports a regression for a
+ configuration whose median exceeds the baseline median by more than both
+ the relative time tolerance and three times the combined MADs of the two
+ runs, so that the noise of a configuration is not mistaken for a
+ slowdown.  It also reports a regression when the peak RSS exceeds the
+ baseline by more than the memory tolerance or PEAKRSS_NOISE_KB, whichever
+ is larger, as the resident memory of the process varies by up to a few
+ hundred KB from one run to the next.
+
+ The peak RSS of a configuration is its own high water mark, because
+ bench_RunConfiguration() resets the peak of the process with
+ bench_ResetPeakRss() before it makes the graph.  It so includes the
+ graph, its extensions and everything the trials allocate, as well as
+ the memory the process holds from before the configuration.  Where the
+ peak cannot be reset, it is that of the process so far, and the gate
+ only detects regressions in configurations that use more memory than
+ all those before them.
+
+ A baseline file is text with one configuration per line:
+
+     # planarity-bench baseline
+     # trials T warmup W seed S extra K
+     # command family N median_ns_per_edge mad_ns_per_edge peak_rss_kb
+     p maxplanar 10000 91.252 1.834 6144
+
+ Configurations that are in only one of the run and the baseline are
+ reported but are not regressions.
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "planarityBench.h"
+
+#define PEAKRSS_NOISE_KB    256
+
+int  _AddBaselineRecord(benchBaseline *baseline, benchBaselineRecord *record);
+benchBaselineRecord *_FindBaselineRecord(benchBaseline *baseline, char command, int family, int N);
+
+/****************************************************************************
+ bench_ReadBaseline()
+ Reads the baseline file into the baseline, which the caller releases with
+ bench_FreeBaseline().
+ ****************************************************************************/
+
+int  bench_ReadBaseline(char *fileName, benchBaseline *baseline)
+{
+	FILE *infile;
+	char line[256], familyName[32];
+	benchBaselineRecord record;
+	int lineNum = 0;
+
+	memset(baseline, 0, sizeof(benchBaseline));
+	baseline->trials = -1;
+
+	if ((infile = fopen(fileName, READTEXT)) == NULL)
+	{
+		fprintf(stderr, "Unable to open baseline '%s'\n", fileName);
+		return NOTOK;
+	}
+
+	while (fgets(line, sizeof(line), infile) != NULL)
+	{
+		lineNum++;
+
+		if (line[0] == '#')
+		{
+			sscanf(line, "# trials %d warmup %d seed %u extra %d",
+					&baseline->trials, &baseline->warmup, &baseline->seed, &baseline->extraEdges);
+			continue;
+		}
+
+		if (strspn(line, " \t\r\n") == strlen(line))
+			continue;
+
+		if (sscanf(line, " %c %31s %d %lf %lf %ld", &record.command, familyName, &record.N,
+					&record.medianNsPerEdge, &record.madNsPerEdge, &record.peakRssKB) != 6 ||
+			(record.family = bench_GetFamily(familyName)) < 0 ||
+			_AddBaselineRecord(baseline, &record) != OK)
+		{
+			fprintf(stderr, "Invalid baseline '%s', line %d\n", fileName, lineNum);
+			fclose(infile);
+			bench_FreeBaseline(baseline);
+			return NOTOK;
+		}
+	}
+
+	fclose(infile);
+
+	if (baseline->trials < 0)
+	{
+		fprintf(stderr, "Baseline '%s' does not record the corpus parameters\n", fileName);
+		bench_FreeBaseline(baseline);
+		return NOTOK;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ _AddBaselineRecord()
+ ****************************************************************************/
+
+int  _AddBaselineRecord(benchBaseline *baseline, benchBaselineRecord *record)
+{
+	if (baseline->numRecords == baseline->capacity)
+	{
+		int newCapacity = baseline->capacity > 0 ? 2 * baseline->capacity : 64;
+		benchBaselineRecord *newRecords = (benchBaselineRecord *)
+				realloc(baseline->records, newCapacity * sizeof(benchBaselineRecord));
+
+		if (newRecords == NULL)
+			return NOTOK;
+
+		baseline->records = newRecords;
+		baseline->capacity = newCapacity;
+	}
+
+	baseline->records[baseline->numRecords++] = *record;
+	return OK;
+}
+
+/****************************************************************************
+ bench_FreeBaseline()
+ ****************************************************************************/
+
+void bench_FreeBaseline(benchBaseline *baseline)
+{
+	if (baseline->records != NULL)
+		free(baseline->records);
+
+	memset(baseline, 0, sizeof(benchBaseline));
+}
+
+/****************************************************************************
+ bench_WriteBaselineHeader()
+ bench_WriteBaselineRecord()
+ ****************************************************************************/
+
+void bench_WriteBaselineHeader(FILE *baselineFile, benchConfig *config)
+{
+	fprintf(baselineFile, "# planarity-bench baseline\n");
+	fprintf(baselineFile, "# trials %d warmup %d seed %u extra %d\n",
+			config->trials, config->warmup, config->seed, config->extraEdges);
+	fprintf(baselineFile, "# command family N median_ns_per_edge mad_ns_per_edge peak_rss_kb\n");
+}
+
+void bench_WriteBaselineRecord(FILE *baselineFile, benchResult *result)
+{
+	fprintf(baselineFile, "%c %s %d %.3f %.3f %ld\n",
+			result->command, familyNames[result->family], result->N,
+			result->medianNsPerEdge, result->madNsPerEdge, result->peakRssKB);
+}
+
+/****************************************************************************
+ bench_CheckBaselineConfig()
+ The run can only be compared to a baseline of the same seeded corpus.
+ ****************************************************************************/
+
+int  bench_CheckBaselineConfig(benchConfig *config, benchBaseline *baseline)
+{
+	if (config->trials != baseline->trials ||
+		config->warmup != baseline->warmup ||
+		config->seed != baseline->seed ||
+		config->extraEdges != baseline->extraEdges)
+	{
+		fprintf(stderr, "The baseline was recorded with -t %d -w %d -s %u -k %d; "
+				"rerun with the same options to compare\n",
+				baseline->trials, baseline->warmup, baseline->seed, baseline->extraEdges);
+		return NOTOK;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ _FindBaselineRecord()
+ ****************************************************************************/
+
+benchBaselineRecord *_FindBaselineRecord(benchBaseline *baseline, char command, int family, int N)
+{
+	int i;
+
+	for (i = 0; i < baseline->numRecords; i++)
+	{
+		if (baseline->records[i].command == command &&
+			baseline->records[i].family == family &&
+			baseline->records[i].N == N)
+			return baseline->records + i;
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ bench_CompareToBaseline()
+ Reports the result against its baseline configuration on stderr.
+ Returns OK if the result is within the tolerances or has no baseline,
+ NOTOK if it is a time or peak RSS regression.
+ ****************************************************************************/
+
+int  bench_CompareToBaseline(benchConfig *config, benchBaseline *baseline, benchResult *result)
+{
+	benchBaselineRecord *record;
+	double allowedTime, noiseTime, change;
+	long allowedKB;
+	int RetVal = OK;
+
+	record = _FindBaselineRecord(baseline, result->command, result->family, result->N);
+	if (record == NULL)
+	{
+		fprintf(stderr, "NEW        %c %s N=%d: %.3f ns/edge, no baseline\n",
+				result->command, familyNames[result->family], result->N,
+				result->medianNsPerEdge);
+		return OK;
+	}
+
+	allowedTime = record->medianNsPerEdge * config->timeTolerance / 100.0;
+	noiseTime = 3.0 * (record->madNsPerEdge + result->madNsPerEdge);
+	if (noiseTime > allowedTime)
+		allowedTime = noiseTime;
+
+	change = record->medianNsPerEdge > 0 ?
+			100.0 * (result->medianNsPerEdge - record->medianNsPerEdge) / record->medianNsPerEdge : 0.0;
+
+	if (result->medianNsPerEdge - record->medianNsPerEdge > allowedTime)
+		RetVal = NOTOK;
+
+	fprintf(stderr, "%-10s %c %s N=%d: %.3f ns/edge vs %.3f baseline (%+.1f%%, limit +%.3f ns/edge)\n",
+			RetVal == OK ? "OK" : "REGRESSION",
+			result->command, familyNames[result->family], result->N,
+			result->medianNsPerEdge, record->medianNsPerEdge, change, allowedTime);
+
+	allowedKB = (long) (record->peakRssKB * config->memTolerance / 100.0);
+	if (allowedKB < PEAKRSS_NOISE_KB)
+		allowedKB = PEAKRSS_NOISE_KB;
+	allowedKB += record->peakRssKB;
+
+	if (result->peakRssKB > allowedKB)
+	{
+		fprintf(stderr, "REGRESSION %c %s N=%d: peak RSS %ld KB vs %ld baseline (limit %ld KB)\n",
+				result->command, familyNames[result->family], result->N,
+				result->peakRssKB, record->peakRssKB, allowedKB);
+		RetVal = NOTOK;
+	}
+
+	return RetVal;
+}
@@ -0,0 +1,203 @@
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+/****************************************************************************
+ Hardware performance counters for planarity-bench
+
+ On Linux, the cycles, instructions, L1 data cache read misses, last level
+ cache misses and branch mispredictions of the benchmark process are counted
+ in user mode with perf_event_open(), as one event group so that a single
+ read() samples them all.  Events the processor or the kernel does not
+ support are left out of the group, and when no event can be opened at all
+ (e.g. in containers where perf_event_paranoid or a seccomp profile forbids
+ it) bench_OpenHwCounters() fails and the benchmark runs without them.
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "planarityBenchCounters.h"
+
+char *hwEventNames[NUM_HWEVENTS] = {
+		"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"
+};
+
+void _ReadHwCounters(hwCounters *counters, unsigned long long *values);
+
+/****************************************************************************
+ bench_OpenHwCounters()
+ Opens the event group and starts counting.
+ Returns OK if at least one event is counted, NOTOK otherwise.
+ ****************************************************************************/
+
+#ifdef __linux__
+
+int  bench_OpenHwCounters(hwCounters *counters)
+{
+	static const struct { unsigned int type; unsigned long long config; } events[NUM_HWEVENTS] = {
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+		{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+		                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+		                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+	};
+	struct perf_event_attr attr;
+	int i, leader = -1, firstErrno = 0;
+
+	memset(counters, 0, sizeof(hwCounters));
+
+	for (i = 0; i < NUM_HWEVENTS; i++)
+	{
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = events[i].type;
+		attr.config = events[i].config;
+		attr.read_format = PERF_FORMAT_GROUP;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+
+		counters->fd[i] = (int) syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+		counters->groupIndex[i] = -1;
+
+		if (counters->fd[i] < 0)
+		{
+			if (firstErrno == 0)
+				firstErrno = errno;
+			counters->fd[i] = -1;
+			continue;
+		}
+
+		if (leader < 0)
+			leader = counters->fd[i];
+		counters->groupIndex[i] = counters->numOpen++;
+	}
+
+	if (counters->numOpen == 0)
+	{
+		fprintf(stderr, "planarity-bench: hardware performance counters unavailable (%s)\n",
+				strerror(firstErrno));
+		return NOTOK;
+	}
+
+	_ReadHwCounters(counters, counters->last);
+	return OK;
+}
+
+/****************************************************************************
+ _ReadHwCounters()
+ Reads the current count of each open event into values, leaving the
+ values of unavailable events at zero.
+ ****************************************************************************/
+
+void _ReadHwCounters(hwCounters *counters, unsigned long long *values)
+{
+	unsigned long long buffer[1 + NUM_HWEVENTS];
+	int i, leader = -1;
+
+	for (i = 0; i < NUM_HWEVENTS; i++)
+	{
+		values[i] = 0;
+		if (leader < 0 && counters->fd[i] >= 0)
+			leader = counters->fd[i];
+	}
+
+	if (leader < 0 || read(leader, buffer, sizeof(buffer)) < (ssize_t) sizeof(unsigned long long))
+		return;
+
+	for (i = 0; i < NUM_HWEVENTS; i++)
+	{
+		if (counters->groupIndex[i] >= 0 && (unsigned long long) counters->groupIndex[i] < buffer[0])
+			values[i] = buffer[1 + counters->groupIndex[i]];
+	}
+}
+
+/****************************************************************************
+ bench_CloseHwCounters()
+ ****************************************************************************/
+
+void bench_CloseHwCounters(hwCounters *counters)
+{
+	int i;
+
+	for (i = NUM_HWEVENTS - 1; i >= 0; i--)
+	{
+		if (counters->fd[i] >= 0)
+			close(counters->fd[i]);
+		counters->fd[i] = -1;
+	}
+	counters->numOpen = 0;
+}
+
+#else
+
+int  bench_OpenHwCounters(hwCounters *counters)
+{
+	int i;
+
+	memset(counters, 0, sizeof(hwCounters));
+	for (i = 0; i < NUM_HWEVENTS; i++)
+	{
+		counters->fd[i] = -1;
+		counters->groupIndex[i] = -1;
+	}
+
+	fprintf(stderr, "planarity-bench: hardware performance counters are only supported on Linux\n");
+	return NOTOK;
+}
+
+void _ReadHwCounters(hwCounters *counters, unsigned long long *values)
+{
+	memset(values, 0, NUM_HWEVENTS * sizeof(unsigned long long));
+}
+
+void bench_CloseHwCounters(hwCounters *counters)
+{
+	counters->numOpen = 0;
+}
+
+#endif
+
+/****************************************************************************
+ bench_ClearHwCounters()
+ Resets the per phase totals, e.g. at the end of the warm-up trials.
+ ****************************************************************************/
+
+void bench_ClearHwCounters(hwCounters *counters)
+{
+	memset(counters->phaseTotals, 0, sizeof(counters->phaseTotals));
+}
+
+/****************************************************************************
+ bench_ObserveEmbedPhase()
+ The embed phase observer (see gp_SetEmbedPhaseObserver()) that charges
+ the events counted since the previous phase boundary to the given phase.
+ ****************************************************************************/
+
+void bench_ObserveEmbedPhase(void *context, int phase)
+{
+	hwCounters *counters = (hwCounters *) context;
+	unsigned long long values[NUM_HWEVENTS];
+	int i;
+
+	_ReadHwCounters(counters, values);
+
+	if (phase >= 0 && phase < NUMEMBEDPHASES)
+	{
+		for (i = 0; i < NUM_HWEVENTS; i++)
+			counters->phaseTotals[phase][i] += values[i] - counters->last[i];
+	}
+
+	memcpy(counters->last, values, sizeof(values));
+}
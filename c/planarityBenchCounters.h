@@ -0,0 +1,55 @@
+#ifndef PLANARITYBENCHCOUNTERS_H
+#define PLANARITYBENCHCOUNTERS_H
+
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "graph.h"
+
+/* Hardware events counted by planarity-bench -hw */
+
+#define HWEVENT_CYCLES          0
+#define HWEVENT_INSTRUCTIONS    1
+#define HWEVENT_L1DMISSES       2
+#define HWEVENT_LLCMISSES       3
+#define HWEVENT_BRANCHMISSES    4
+#define NUM_HWEVENTS            5
+
+extern char *hwEventNames[NUM_HWEVENTS];
+
+/********************************************************************
+ The hardware performance counters of the benchmark, read at each
+ phase boundary of gp_Embed() by bench_ObserveEmbedPhase().
+        numOpen: the number of events that could be counted
+        fd: file descriptor per event, or -1 if the event is unavailable
+        groupIndex: position of each event's value in a group read
+        last: the readings at the previous phase boundary
+        phaseTotals: counts accumulated per phase of gp_Embed()
+*/
+
+typedef struct
+{
+    int numOpen;
+    int fd[NUM_HWEVENTS];
+    int groupIndex[NUM_HWEVENTS];
+    unsigned long long last[NUM_HWEVENTS];
+    unsigned long long phaseTotals[NUMEMBEDPHASES][NUM_HWEVENTS];
+} hwCounters;
+
+int  bench_OpenHwCounters(hwCounters *counters);
+void bench_CloseHwCounters(hwCounters *counters);
+void bench_ClearHwCounters(hwCounters *counters);
+void bench_ObserveEmbedPhase(void *context, int phase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -164,9 +164,9 @@ int runSpecificGraphTest(char *command, char *infileName);
 int runQuickRegressionTests(int argc, char *argv[])
 {
 	if (runSpecificGraphTests() < 0)
-		return -1;
+		return NOTOK;
 
-	return 0;
+	return OK;
 }
 
 int runSpecificGraphTests()
@@ -212,6 +212,23 @@ int runSpecificGraphTests()
 	if (runSpecificGraphTest("-4", "Petersen.txt") < 0)
 		retVal = -1;
 
+	// K12 has more edges than the default arc capacity, so gp_Read()
+	// must size the edge storage to keep all of them
+	if (runSpecificGraphTest("-p", "K12.txt") < 0)
+		retVal = -1;
+
+	if (runSpecificGraphTest("-o", "K12.txt") < 0)
+		retVal = -1;
+
+	if (runSpecificGraphTest("-2", "K12.txt") < 0)
+		retVal = -1;
+
+	if (runSpecificGraphTest("-3", "K12.txt") < 0)
+		retVal = -1;
+
+	if (runSpecificGraphTest("-4", "K12.txt") < 0)
+		retVal = -1;
+
 #endif
 
 	if (runSpecificGraphTest("-p", "maxPlanar5.0-based.txt") < 0)
@@ -238,6 +255,21 @@ int runSpecificGraphTests()
 	if (runSpecificGraphTest("-4", "Petersen.0-based.txt") < 0)
 		retVal = -1;
 
+	if (runSpecificGraphTest("-p", "K12.0-based.txt") < 0)
+		retVal = -1;
+
+	if (runSpecificGraphTest("-o", "K12.0-based.txt") < 0)
+		retVal = -1;
+
+	if (runSpecificGraphTest("-2", "K12.0-based.txt") < 0)
+		retVal = -1;
+
+	if (runSpecificGraphTest("-3", "K12.0-based.txt") < 0)
+		retVal = -1;
+
+	if (runSpecificGraphTest("-4", "K12.0-based.txt") < 0)
+		retVal = -1;
+
 	if (retVal == 0)
 		printf("Tests of all specific graphs succeeded\n");
 
@@ -337,7 +369,9 @@ int runSpecificGraphTest(char *command, char *infileName)
 int callRandomGraphs(int argc, char *argv[])
 {
 	char Choice = 0;
-	int offset = 0, NumGraphs, SizeOfGraphs;
+	int offset = 0, NumGraphs, SizeOfGraphs, tailSize = 0, i;
+	unsigned int seed = 0;
+	char *tailFileName = NULL;
 
 	if (argc < 5)
 		return -1;
@@ -353,7 +387,20 @@ int callRandomGraphs(int argc, char *argv[])
 	NumGraphs = atoi(argv[3+offset]);
 	SizeOfGraphs = atoi(argv[4+offset]);
 
-    return RandomGraphs(Choice, NumGraphs, SizeOfGraphs);
+	for (i = 5+offset; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-seed") == 0 && i+1 < argc)
+			seed = (unsigned int) strtoul(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "-tail") == 0 && i+2 < argc)
+		{
+			tailSize = atoi(argv[++i]);
+			tailFileName = argv[++i];
+		}
+		else
+			return -1;
+	}
+
+    return RandomGraphsEx(Choice, NumGraphs, SizeOfGraphs, seed, tailSize, tailFileName);
 }
 
 /****************************************************************************
@@ -0,0 +1,624 @@
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+/****************************************************************************
+ planarity-libtest
+
+ Tests of library functions that the sample graphs of planarity -test do
+ not reach.  Each test is selected by the first argument, and the program
+ exits with 0 if it passes, or reports each failure on stderr and exits
+ with 1.
+
+     trim  - gp_Trim() keeps the embedding or obstruction of each algorithm,
+             which is written the same before and after trimming, and the
+             functions that need the released memory fail on the result
+     pool  - threads acquire, embed and release graphs of each algorithm
+             with gp_PoolAcquire() and gp_PoolRelease() while one of them
+             calls gp_PoolClear(), and each result passes its integrity test
+     alloc - graphs of each algorithm, with and without an arena, are
+             attached, read, copied, embedded, rendered, trimmed and freed
+             with counting allocators, both as the default allocator and as
+             the allocator of the graph, and every block is freed by the
+             allocator that allocated it
+
+ The tests generate seeded random graphs, and the files they write are
+ left in the working directory.
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "graph.h"
+#include "graphDrawPlanar.h"
+#include "planarityAlgorithms.h"
+
+#define LIBTEST_COMMANDS    "pdo234"
+#define LIBTEST_SEED        17
+
+#define LIBTEST_BEFORE      "libtest.before.txt"
+#define LIBTEST_AFTER       "libtest.after.txt"
+#define LIBTEST_RENDER      "libtest.render.txt"
+#define LIBTEST_RERENDER    "libtest.rerender.txt"
+
+#define LIBTEST_POOLTHREADS     4
+#define LIBTEST_POOLITERATIONS  300
+#define LIBTEST_POOLCLEARPERIOD 50
+
+typedef struct
+{
+	int  threadIndex;
+	unsigned int seed;
+	int  numFailures;
+} poolWorker;
+
+int  libtest_Trim(void);
+int  libtest_TrimGraph(char command, int N, int numEdges);
+
+int  libtest_Pool(void);
+#ifdef WIN32
+DWORD WINAPI libtest_PoolThread(LPVOID arg);
+#else
+void *libtest_PoolThread(void *arg);
+#endif
+int  libtest_PoolGraph(poolWorker *worker, int N, char command);
+int  libtest_Random(unsigned int *pSeed, int range);
+
+#define LIBTEST_ALLOCMAGIC  0x5EED
+
+typedef struct
+{
+	size_t tag;
+	size_t pad;
+} allocHeader;
+
+typedef struct
+{
+	size_t id;
+	long numAllocs, numLive, numForeign;
+} allocCounter;
+
+int  libtest_Alloc(void);
+int  libtest_AllocGraph(char command, int N, int allocFlags, graphAllocatorP theAllocator);
+graphP libtest_NewGraph(char command, int allocFlags, graphAllocatorP theAllocator);
+
+void *libtest_CountingAlloc(void *context, size_t size);
+void *libtest_CountingRealloc(void *context, void *memory, size_t size);
+void libtest_CountingFree(void *context, void *memory);
+
+int  libtest_FilesEqual(char *file1Name, char *file2Name);
+int  libtest_Failed(char *testName, char command, int N, char *what);
+
+/****************************************************************************
+ MAIN
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	int Result = NOTOK;
+
+	if (argc == 2 && strcmp(argv[1], "trim") == 0)
+		Result = libtest_Trim();
+	else if (argc == 2 && strcmp(argv[1], "pool") == 0)
+		Result = libtest_Pool();
+	else if (argc == 2 && strcmp(argv[1], "alloc") == 0)
+		Result = libtest_Alloc();
+	else
+	{
+		fprintf(stderr, "Usage: planarity-libtest trim|pool|alloc\n");
+		return 1;
+	}
+
+	printf("%s %s\n", argv[1], Result == OK ? "passed" : "FAILED");
+	return Result == OK ? 0 : 1;
+}
+
+/****************************************************************************
+ libtest_Trim()
+ Trims the results of each algorithm on graphs that are sparse, that are
+ maximal planar, and that have more edges than a planar graph can have,
+ so that both embeddings and obstructions are trimmed.  A graph with an
+ arena is not trimmed.
+ ****************************************************************************/
+
+int  libtest_Trim(void)
+{
+	int Result = OK, N, trial;
+	char *command;
+	graphP theGraph;
+
+	srand(LIBTEST_SEED);
+
+	for (command = LIBTEST_COMMANDS; *command != '\0'; command++)
+	{
+		for (trial = 0; trial < 10; trial++)
+		{
+			N = 10 + rand() % 200;
+
+			if (libtest_TrimGraph(*command, N, N) != OK ||
+				libtest_TrimGraph(*command, N, 3*N - 6) != OK ||
+				libtest_TrimGraph(*command, N, 3*N - 6 + 1 + rand() % N) != OK)
+				Result = NOTOK;
+		}
+	}
+
+	theGraph = gp_New();
+	if (theGraph == NULL ||
+		gp_SetAllocFlags(theGraph, ALLOCFLAGS_ARENA) != OK ||
+		gp_InitGraph(theGraph, 100) != OK ||
+		gp_Trim(theGraph) != NOTOK || gp_IsTrimmed(theGraph))
+		Result = libtest_Failed("trim", 'p', 100, "a graph with an arena was trimmed");
+	gp_Free(&theGraph);
+
+	return Result;
+}
+
+/****************************************************************************
+ libtest_TrimGraph()
+ Embeds a random graph of N vertices and numEdges edges with the algorithm
+ of the command, then trims the result and checks that it is unchanged.
+ ****************************************************************************/
+
+int  libtest_TrimGraph(char command, int N, int numEdges)
+{
+	int Result = OK, embedResult;
+	graphP theGraph = gp_New(), origGraph = NULL;
+	graphMemoryUsage before, after;
+
+	if (theGraph == NULL || AttachAlgorithm(theGraph, command) != OK ||
+		gp_InitGraph(theGraph, N) != OK ||
+		gp_CreateRandomGraphEx(theGraph, numEdges) != OK ||
+		(origGraph = gp_DupGraph(theGraph)) == NULL)
+	{
+		Result = libtest_Failed("trim", command, N, "unable to create the graph");
+	}
+
+	else if ((embedResult = gp_Embed(theGraph, GetEmbedFlags(command))) == NOTOK ||
+			 gp_TestEmbedResultIntegrity(theGraph, origGraph, embedResult) != embedResult ||
+			 gp_SortVertices(theGraph) != OK ||
+			 gp_Write(theGraph, LIBTEST_BEFORE, WRITE_ADJLIST) != OK ||
+			 (command == 'd' && embedResult == OK &&
+			  gp_DrawPlanar_RenderToFile(theGraph, LIBTEST_RENDER) != OK) ||
+			 gp_GetMemoryUsage(theGraph, &before) != OK)
+	{
+		Result = libtest_Failed("trim", command, N, "unable to embed the graph");
+	}
+
+	else if (gp_Trim(theGraph) != OK || !gp_IsTrimmed(theGraph) || gp_Trim(theGraph) != OK)
+		Result = libtest_Failed("trim", command, N, "gp_Trim() failed");
+
+	else
+	{
+		if (gp_GetMemoryUsage(theGraph, &after) != OK || after.total >= before.total)
+			Result = libtest_Failed("trim", command, N, "the memory usage did not shrink");
+
+		if (gp_Write(theGraph, LIBTEST_AFTER, WRITE_ADJLIST) != OK ||
+			!libtest_FilesEqual(LIBTEST_BEFORE, LIBTEST_AFTER))
+			Result = libtest_Failed("trim", command, N, "the adjacency lists changed");
+
+		if (command == 'd' && embedResult == OK &&
+			(gp_DrawPlanar_RenderToFile(theGraph, LIBTEST_RERENDER) != OK ||
+			 !libtest_FilesEqual(LIBTEST_RENDER, LIBTEST_RERENDER)))
+			Result = libtest_Failed("trim", command, N, "the drawing changed");
+
+		if (gp_Embed(theGraph, GetEmbedFlags(command)) != NOTOK)
+			Result = libtest_Failed("trim", command, N, "gp_Embed() did not fail");
+
+		if (gp_EnsureArcCapacity(theGraph, 2 * gp_GetArcCapacity(theGraph)) != NOTOK)
+			Result = libtest_Failed("trim", command, N, "gp_EnsureArcCapacity() did not fail");
+
+		if (gp_Write(theGraph, LIBTEST_AFTER, WRITE_DEBUGINFO) != NOTOK)
+			Result = libtest_Failed("trim", command, N, "gp_Write(WRITE_DEBUGINFO) did not fail");
+
+		if (gp_DupGraph(theGraph) != NULL)
+			Result = libtest_Failed("trim", command, N, "gp_DupGraph() did not fail");
+	}
+
+	gp_Free(&theGraph);
+	gp_Free(&origGraph);
+	return Result;
+}
+
+/****************************************************************************
+ libtest_Pool()
+ Runs LIBTEST_POOLTHREADS threads of libtest_PoolThread(), then checks that
+ a released graph is reused, that a graph not made by the pool is freed
+ by gp_PoolRelease(), and that invalid requests are refused.
+ ****************************************************************************/
+
+int  libtest_Pool(void)
+{
+	poolWorker workers[LIBTEST_POOLTHREADS];
+#ifdef WIN32
+	HANDLE threads[LIBTEST_POOLTHREADS];
+#else
+	pthread_t threads[LIBTEST_POOLTHREADS];
+#endif
+	int  Result = OK, numStarted, t;
+	graphP theGraph, releasedGraph;
+
+	for (numStarted = 0; numStarted < LIBTEST_POOLTHREADS; numStarted++)
+	{
+		workers[numStarted].threadIndex = numStarted;
+		workers[numStarted].seed = LIBTEST_SEED + numStarted;
+		workers[numStarted].numFailures = 0;
+#ifdef WIN32
+		if ((threads[numStarted] = CreateThread(NULL, 0, libtest_PoolThread, &workers[numStarted], 0, NULL)) == NULL)
+			break;
+#else
+		if (pthread_create(&threads[numStarted], NULL, libtest_PoolThread, &workers[numStarted]) != 0)
+			break;
+#endif
+	}
+
+	if (numStarted < LIBTEST_POOLTHREADS)
+		Result = libtest_Failed("pool", ' ', 0, "unable to start the threads");
+
+	for (t = 0; t < numStarted; t++)
+	{
+#ifdef WIN32
+		WaitForSingleObject(threads[t], INFINITE);
+		CloseHandle(threads[t]);
+#else
+		pthread_join(threads[t], NULL);
+#endif
+		if (workers[t].numFailures > 0)
+			Result = NOTOK;
+	}
+
+	// A released graph is handed back to the next matching request
+	theGraph = gp_PoolAcquire(20, 0, EMBEDFLAGS_SEARCHFORK33);
+	releasedGraph = theGraph;
+	gp_PoolRelease(&theGraph);
+	if (theGraph != NULL || (theGraph = gp_PoolAcquire(20, 0, EMBEDFLAGS_SEARCHFORK33)) != releasedGraph)
+		Result = libtest_Failed("pool", '3', 20, "the released graph was not reused");
+	gp_PoolRelease(&theGraph);
+
+	// A graph not made by the pool is freed
+	theGraph = gp_New();
+	if (theGraph == NULL || gp_InitGraph(theGraph, 20) != OK)
+		Result = libtest_Failed("pool", 'p', 20, "unable to create the graph");
+	gp_PoolRelease(&theGraph);
+	if (theGraph != NULL)
+		Result = libtest_Failed("pool", 'p', 20, "gp_PoolRelease() kept the pointer");
+
+	if (gp_PoolAcquire(0, 0, EMBEDFLAGS_PLANAR) != NULL ||
+		gp_PoolAcquire(20, 3, EMBEDFLAGS_PLANAR) != NULL ||
+		gp_PoolAcquire(20, 0, 0) != NULL)
+		Result = libtest_Failed("pool", ' ', 20, "an invalid request was served");
+
+	gp_PoolClear();
+	return Result;
+}
+
+/****************************************************************************
+ libtest_PoolThread()
+ Embeds LIBTEST_POOLITERATIONS pooled graphs of random orders and
+ algorithms.  The first thread also clears the pool periodically, while
+ the others are using it.
+ ****************************************************************************/
+
+#ifdef WIN32
+DWORD WINAPI libtest_PoolThread(LPVOID arg)
+#else
+void *libtest_PoolThread(void *arg)
+#endif
+{
+	poolWorker *worker = (poolWorker *) arg;
+	int  i, N;
+	char command;
+
+	for (i = 0; i < LIBTEST_POOLITERATIONS; i++)
+	{
+		N = 10 + 5 * libtest_Random(&worker->seed, 3);
+		command = LIBTEST_COMMANDS[libtest_Random(&worker->seed, (int) strlen(LIBTEST_COMMANDS))];
+
+		if (libtest_PoolGraph(worker, N, command) != OK)
+			worker->numFailures++;
+
+		if (worker->threadIndex == 0 && i % LIBTEST_POOLCLEARPERIOD == 0)
+			gp_PoolClear();
+	}
+
+	return 0;
+}
+
+/****************************************************************************
+ libtest_PoolGraph()
+ Acquires a graph of order N for the algorithm of the command, adds random
+ edges, embeds it and tests the result.  The graph is then released to
+ the pool, or sometimes trimmed before release or freed instead, both of
+ which must free it.
+ ****************************************************************************/
+
+int  libtest_PoolGraph(poolWorker *worker, int N, char command)
+{
+	int  Result = OK, embedResult, i, u, v;
+	graphP theGraph, origGraph = NULL;
+
+	if ((theGraph = gp_PoolAcquire(N, 0, GetEmbedFlags(command))) == NULL)
+		return libtest_Failed("pool", command, N, "gp_PoolAcquire() failed");
+
+	if (theGraph->N != N || theGraph->M != 0 || gp_GetArcCapacity(theGraph) < 2 * DEFAULT_EDGE_LIMIT * N)
+		Result = libtest_Failed("pool", command, N, "the acquired graph is not new");
+
+	for (i = 0; i < 2 * N; i++)
+	{
+		u = gp_GetFirstVertex(theGraph) + libtest_Random(&worker->seed, N);
+		v = gp_GetFirstVertex(theGraph) + libtest_Random(&worker->seed, N);
+		if (u != v && !gp_IsNeighbor(theGraph, u, v) && gp_AddEdge(theGraph, u, 0, v, 0) != OK)
+			Result = libtest_Failed("pool", command, N, "gp_AddEdge() failed");
+	}
+
+	if ((origGraph = gp_DupGraph(theGraph)) == NULL)
+		Result = libtest_Failed("pool", command, N, "gp_DupGraph() failed");
+
+	else if ((embedResult = gp_Embed(theGraph, GetEmbedFlags(command))) == NOTOK ||
+			 gp_TestEmbedResultIntegrity(theGraph, origGraph, embedResult) != embedResult)
+		Result = libtest_Failed("pool", command, N, "the embedding failed its integrity test");
+
+	gp_Free(&origGraph);
+
+	switch (libtest_Random(&worker->seed, 8))
+	{
+		case 0 : gp_Free(&theGraph); break;
+		case 1 : gp_Trim(theGraph); gp_PoolRelease(&theGraph); break;
+		default : gp_PoolRelease(&theGraph); break;
+	}
+
+	return Result;
+}
+
+/****************************************************************************
+ libtest_Random()
+ Returns a pseudo-random number in [0, range) from the generator state at
+ pSeed, which each thread keeps for itself
+ ****************************************************************************/
+
+int  libtest_Random(unsigned int *pSeed, int range)
+{
+	*pSeed = *pSeed * 1103515245U + 12345U;
+	return (int) ((*pSeed >> 16) % (unsigned int) range);
+}
+
+/****************************************************************************
+ libtest_Alloc()
+ Runs libtest_AllocGraph() for each algorithm, with and without an arena,
+ once with a counting allocator as the default allocator and once with
+ another as the allocator of each graph.  Once the default allocator is
+ restored, both must have allocated blocks, freed all of them, and seen
+ no block of the other or of the C library.
+ ****************************************************************************/
+
+int  libtest_Alloc(void)
+{
+	allocCounter defaultCounter = { 1, 0, 0, 0 }, graphCounter = { 2, 0, 0, 0 };
+	graphAllocator defaultAllocator = { libtest_CountingAlloc, libtest_CountingRealloc, libtest_CountingFree, &defaultCounter };
+	graphAllocator perGraphAllocator = { libtest_CountingAlloc, libtest_CountingRealloc, libtest_CountingFree, &graphCounter };
+	graphAllocator invalidAllocator = { libtest_CountingAlloc, NULL, libtest_CountingFree, &defaultCounter };
+	int  Result = OK, allocFlags, trial;
+	char *command;
+
+	if (gp_SetAllocator(&invalidAllocator) != NOTOK || gp_NewWithAllocator(&invalidAllocator) != NULL)
+		Result = libtest_Failed("alloc", ' ', 0, "an allocator without gp_ReallocMemory() was accepted");
+
+	if (gp_SetAllocator(&defaultAllocator) != OK)
+		return libtest_Failed("alloc", ' ', 0, "gp_SetAllocator() failed");
+
+	srand(LIBTEST_SEED);
+
+	for (allocFlags = 0; allocFlags <= ALLOCFLAGS_ARENA; allocFlags += ALLOCFLAGS_ARENA)
+	{
+		for (command = LIBTEST_COMMANDS; *command != '\0'; command++)
+		{
+			for (trial = 0; trial < 5; trial++)
+			{
+				if (libtest_AllocGraph(*command, 10 + rand() % 200, allocFlags, NULL) != OK ||
+					libtest_AllocGraph(*command, 10 + rand() % 200, allocFlags, &perGraphAllocator) != OK)
+					Result = NOTOK;
+			}
+		}
+	}
+
+	gp_SetAllocator(NULL);
+
+	if (defaultCounter.numAllocs == 0 || graphCounter.numAllocs == 0)
+		Result = libtest_Failed("alloc", ' ', 0, "an allocator was not used");
+
+	if (defaultCounter.numLive != 0 || graphCounter.numLive != 0)
+	{
+		fprintf(stderr, "alloc: %ld and %ld blocks were not freed\n", defaultCounter.numLive, graphCounter.numLive);
+		Result = NOTOK;
+	}
+
+	if (defaultCounter.numForeign != 0 || graphCounter.numForeign != 0)
+	{
+		fprintf(stderr, "alloc: %ld and %ld foreign blocks were freed or resized\n",
+				defaultCounter.numForeign, graphCounter.numForeign);
+		Result = NOTOK;
+	}
+
+	return Result;
+}
+
+/****************************************************************************
+ libtest_AllocGraph()
+ Writes a random graph of order N, then reads it into a new graph, copies
+ it, embeds it with the algorithm of the command and tests the result,
+ renders a drawing, trims it and frees both graphs.  The graphs use
+ theAllocator, or the default allocator if it is NULL.
+ ****************************************************************************/
+
+int  libtest_AllocGraph(char command, int N, int allocFlags, graphAllocatorP theAllocator)
+{
+	int  Result = OK, embedResult;
+	graphP theGraph, origGraph = NULL;
+
+	if ((theGraph = libtest_NewGraph(command, allocFlags, theAllocator)) == NULL ||
+		gp_InitGraph(theGraph, N) != OK ||
+		gp_CreateRandomGraphEx(theGraph, 3*N - 6 + rand() % N) != OK ||
+		gp_Write(theGraph, LIBTEST_BEFORE, WRITE_ADJLIST) != OK)
+		Result = libtest_Failed("alloc", command, N, "unable to create the graph");
+	gp_Free(&theGraph);
+
+	if (Result != OK)
+		return Result;
+
+	if ((theGraph = libtest_NewGraph(command, allocFlags, theAllocator)) == NULL ||
+		gp_Read(theGraph, LIBTEST_BEFORE) != OK ||
+		gp_EnsureArcCapacity(theGraph, 2 * gp_GetArcCapacity(theGraph)) != OK ||
+		(origGraph = gp_DupGraph(theGraph)) == NULL ||
+		gp_SetEmbedOptions(theGraph, EMBEDOPTIONS_COMPACTARCS) != OK)
+	{
+		Result = libtest_Failed("alloc", command, N, "unable to read the graph");
+	}
+
+	else if ((embedResult = gp_Embed(theGraph, GetEmbedFlags(command))) == NOTOK ||
+			 gp_TestEmbedResultIntegrity(theGraph, origGraph, embedResult) != embedResult)
+	{
+		Result = libtest_Failed("alloc", command, N, "the embedding failed its integrity test");
+	}
+
+	else if (gp_SortVertices(theGraph) != OK ||
+			 (command == 'd' && embedResult == OK &&
+			  gp_DrawPlanar_RenderToFile(theGraph, LIBTEST_RENDER) != OK) ||
+			 gp_Write(theGraph, LIBTEST_AFTER, WRITE_ADJLIST) != OK ||
+			 (allocFlags == 0 && gp_Trim(theGraph) != OK))
+	{
+		Result = libtest_Failed("alloc", command, N, "unable to write the result");
+	}
+
+	gp_Free(&theGraph);
+	gp_Free(&origGraph);
+	return Result;
+}
+
+/****************************************************************************
+ libtest_NewGraph()
+ Returns a new graph with theAllocator, or the default allocator if it is
+ NULL, with the allocFlags set and the extension of the command attached
+ ****************************************************************************/
+
+graphP libtest_NewGraph(char command, int allocFlags, graphAllocatorP theAllocator)
+{
+	graphP theGraph = theAllocator != NULL ? gp_NewWithAllocator(theAllocator) : gp_New();
+
+	if (theGraph != NULL &&
+		(gp_SetAllocFlags(theGraph, allocFlags) != OK || AttachAlgorithm(theGraph, command) != OK))
+		gp_Free(&theGraph);
+
+	return theGraph;
+}
+
+/****************************************************************************
+ libtest_CountingAlloc()
+ libtest_CountingRealloc()
+ libtest_CountingFree()
+ The functions of a counting allocator, whose context is an allocCounter.
+ Each block has a header tagged with the id of the counter, so a block
+ freed or resized by another allocator is counted as foreign and left
+ alone.
+ ****************************************************************************/
+
+void *libtest_CountingAlloc(void *context, size_t size)
+{
+	allocCounter *counter = (allocCounter *) context;
+	allocHeader *header = (allocHeader *) malloc(sizeof(allocHeader) + size);
+
+	if (header == NULL)
+		return NULL;
+
+	header->tag = LIBTEST_ALLOCMAGIC + counter->id;
+	counter->numAllocs++;
+	counter->numLive++;
+	return header + 1;
+}
+
+void *libtest_CountingRealloc(void *context, void *memory, size_t size)
+{
+	allocCounter *counter = (allocCounter *) context;
+	allocHeader *header;
+
+	if (memory == NULL)
+		return libtest_CountingAlloc(context, size);
+
+	header = (allocHeader *) memory - 1;
+	if (header->tag != LIBTEST_ALLOCMAGIC + counter->id)
+	{
+		counter->numForeign++;
+		return NULL;
+	}
+
+	if ((header = (allocHeader *) realloc(header, sizeof(allocHeader) + size)) == NULL)
+		return NULL;
+
+	return header + 1;
+}
+
+void libtest_CountingFree(void *context, void *memory)
+{
+	allocCounter *counter = (allocCounter *) context;
+	allocHeader *header;
+
+	if (memory == NULL)
+		return;
+
+	header = (allocHeader *) memory - 1;
+	if (header->tag != LIBTEST_ALLOCMAGIC + counter->id)
+	{
+		counter->numForeign++;
+		return;
+	}
+
+	header->tag = 0;
+	counter->numLive--;
+	free(header);
+}
+
+/****************************************************************************
+ libtest_FilesEqual()
+ Returns TRUE if the two files can be read and have the same content
+ ****************************************************************************/
+
+int  libtest_FilesEqual(char *file1Name, char *file2Name)
+{
+	FILE *file1 = fopen(file1Name, "rb"), *file2 = fopen(file2Name, "rb");
+	int  c1 = EOF, c2 = EOF, Result = FALSE;
+
+	if (file1 != NULL && file2 != NULL)
+	{
+		do {
+			c1 = fgetc(file1);
+			c2 = fgetc(file2);
+		} while (c1 == c2 && c1 != EOF);
+
+		Result = c1 == c2;
+	}
+
+	if (file1 != NULL)
+		fclose(file1);
+	if (file2 != NULL)
+		fclose(file2);
+
+	return Result;
+}
+
+/****************************************************************************
+ libtest_Failed()
+ Reports a failure of a test and returns NOTOK
+ ****************************************************************************/
+
+int  libtest_Failed(char *testName, char command, int N, char *what)
+{
+	fprintf(stderr, "%s: -%c on %d vertices: %s\n", testName, command, N, what);
+	return NOTOK;
+}
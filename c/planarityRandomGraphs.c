@@ -6,9 +6,24 @@ See the LICENSE.TXT file for licensing information.
 
 #include "planarity.h"
 
+/* A record of one of the slowest graphs of a random graph campaign */
+
+typedef struct
+{
+	int  graphNum;
+	unsigned int seed;
+	unsigned long long latencyNs;
+	int  result;
+	embedStats stats;
+} tailRecord;
+
 void GetNumberIfZero(int *pNum, char *prompt, int min, int max);
 void ReinitializeGraph(graphP *pGraph, int ReuseGraphs, char command);
 graphP MakeGraph(int Size, char command);
+void UpdateTail(tailRecord *tail, int tailSize, int *pNumTail, tailRecord *candidate);
+int  CompareTailRecords(const void *a, const void *b);
+int  WriteTail(char *tailFileName, tailRecord *tail, int numTail, graphP theGraph,
+			   char command, int NumGraphs, unsigned int campaignSeed);
 
 /****************************************************************************
  RandomGraphs()
@@ -22,6 +37,26 @@ graphP MakeGraph(int Size, char command);
 #define NUM_MINORS  9
 
 int  RandomGraphs(char command, int NumGraphs, int SizeOfGraphs)
+{
+	return RandomGraphsEx(command, NumGraphs, SizeOfGraphs, 0, 0, NULL);
+}
+
+/****************************************************************************
+ RandomGraphsEx()
+ Extends RandomGraphs() with reproducible campaigns and tail latency capture.
+
+ Graph K of the campaign is generated from the random seed (seed + K), so
+ any graph can be regenerated from its seed, e.g. by a campaign of one graph
+ with that seed.  A seed of 0 selects the current time, which is reported.
+
+ If tailSize is positive, the embedding time of each graph is measured and
+ the tailSize slowest graphs are written to tailFileName along with their
+ seeds and embedding statistics, and each of them is also written in
+ adjacency list format to tailFileName.R.txt, where R is its rank.
+ ****************************************************************************/
+
+int  RandomGraphsEx(char command, int NumGraphs, int SizeOfGraphs,
+					unsigned int seed, int tailSize, char *tailFileName)
 {
 char theFileName[256];
 int  K, countUpdateFreq;
@@ -31,15 +66,28 @@ graphP theGraph=NULL, origGraph=NULL;
 platform_time start, end;
 int embedFlags = GetEmbedFlags(command);
 int ReuseGraphs = TRUE;
+tailRecord *tail = NULL, candidate;
+int numTail = 0;
+unsigned long long embedStart;
 
      GetNumberIfZero(&NumGraphs, "Enter number of graphs to generate:", 1, 1000000000);
      GetNumberIfZero(&SizeOfGraphs, "Enter size of graphs:", 1, 10000);
 
+     if (tailSize > 0 && (tailFileName == NULL ||
+    	 (tail = (tailRecord *) malloc(tailSize * sizeof(tailRecord))) == NULL))
+     {
+    	 ErrorMessage("Unable to capture the tail of the campaign.\n");
+    	 return NOTOK;
+     }
+
    	 theGraph = MakeGraph(SizeOfGraphs, command);
    	 origGraph = MakeGraph(SizeOfGraphs, command);
    	 if (theGraph == NULL || origGraph == NULL)
    	 {
    		 gp_Free(&theGraph);
+   		 gp_Free(&origGraph);
+   		 if (tail != NULL)
+   			 free(tail);
    		 return NOTOK;
    	 }
 
@@ -47,9 +95,10 @@ int ReuseGraphs = TRUE;
      for (K=0; K < NUM_MINORS; K++)
           ObstructionMinorFreqs[K] = 0;
 
-   	 // Seed the random number generator with "now". Do it after any prompting
-   	 // to tie randomness to human process of answering the prompt.
-   	 srand(time(NULL));
+   	 // Unless a seed was given, seed the campaign with "now". Do it after any
+   	 // prompting to tie randomness to human process of answering the prompt.
+   	 if (seed == 0)
+   		 seed = (unsigned int) time(NULL);
 
    	 // Select a counter update frequency that updates more frequently with larger graphs
    	 // and which is relatively prime with 10 so that all digits of the count will change
@@ -69,6 +118,8 @@ int ReuseGraphs = TRUE;
      // Generate and process the number of graphs requested
      for (K=0; K < NumGraphs; K++)
      {
+          srand(seed + K);
+
           if ((Result = gp_CreateRandomGraph(theGraph)) == OK)
           {
               if (tolower(OrigOut)=='y')
@@ -81,8 +132,24 @@ int ReuseGraphs = TRUE;
 
               if (strchr("pdo234", command))
               {
+                  if (tail != NULL)
+                  {
+                      gp_ClearEmbedStats(theGraph);
+                      embedStart = platform_GetTimeNs();
+                  }
+
                   Result = gp_Embed(theGraph, embedFlags);
 
+                  if (tail != NULL)
+                  {
+                      candidate.latencyNs = platform_GetTimeNs() - embedStart;
+                      candidate.graphNum = K;
+                      candidate.seed = seed + K;
+                      candidate.result = Result;
+                      gp_GetEmbedStats(theGraph, &candidate.stats);
+                      UpdateTail(tail, tailSize, &numTail, &candidate);
+                  }
+
                   if (gp_TestEmbedResultIntegrity(theGraph, origGraph, Result) != Result)
                       Result = NOTOK;
 
@@ -170,6 +237,17 @@ int ReuseGraphs = TRUE;
      fprintf(stdout, "%d\n", NumGraphs);
      fflush(stdout);
 
+     // Write the slowest graphs, which are regenerated from their seeds
+     if (tail != NULL)
+     {
+         if (WriteTail(tailFileName, tail, numTail, origGraph, command, NumGraphs, seed) != OK)
+         {
+             ErrorMessage("Unable to write the tail of the campaign.\n");
+             Result = NOTOK;
+         }
+         free(tail);
+     }
+
      // Free the graph structures created before the loop
      gp_Free(&theGraph);
      gp_Free(&origGraph);
@@ -179,6 +257,8 @@ int ReuseGraphs = TRUE;
          Message("\nNo Errors Found.");
      sprintf(Line, "\nDone (%.3lf seconds).\n", platform_GetDuration(start,end));
      Message(Line);
+     sprintf(Line, "Seed=%u.\n", seed);
+     Message(Line);
 
      // Report statistics for planar or outerplanar embedding
      if (embedFlags == EMBEDFLAGS_PLANAR || embedFlags == EMBEDFLAGS_OUTERPLANAR)
@@ -239,6 +319,100 @@ int ReuseGraphs = TRUE;
      return Result==OK || Result==NONEMBEDDABLE ? OK : NOTOK;
 }
 
+/****************************************************************************
+ UpdateTail()
+ Keeps the tailSize slowest graphs seen so far, replacing the fastest one
+ in the tail once it is full.
+ ****************************************************************************/
+
+void UpdateTail(tailRecord *tail, int tailSize, int *pNumTail, tailRecord *candidate)
+{
+	int i, fastest = 0;
+
+	if (*pNumTail < tailSize)
+	{
+		tail[(*pNumTail)++] = *candidate;
+		return;
+	}
+
+	for (i = 1; i < tailSize; i++)
+		if (tail[i].latencyNs < tail[fastest].latencyNs)
+			fastest = i;
+
+	if (candidate->latencyNs > tail[fastest].latencyNs)
+		tail[fastest] = *candidate;
+}
+
+/****************************************************************************
+ CompareTailRecords()
+ Orders tail records from slowest to fastest.
+ ****************************************************************************/
+
+int  CompareTailRecords(const void *a, const void *b)
+{
+	const tailRecord *x = (const tailRecord *) a, *y = (const tailRecord *) b;
+
+	return x->latencyNs < y->latencyNs ? 1 : (x->latencyNs > y->latencyNs ? -1 : 0);
+}
+
+/****************************************************************************
+ WriteTail()
+ Writes the tail records, slowest first, to tailFileName, and regenerates
+ each tail graph from its seed in theGraph to write it to tailFileName.R.txt.
+ The embedding statistics are the phase times and, if the library was built
+ with EMBEDCOUNTERS, the hot path event counts of the graph's embedding.
+ ****************************************************************************/
+
+int  WriteTail(char *tailFileName, tailRecord *tail, int numTail, graphP theGraph,
+			   char command, int NumGraphs, unsigned int campaignSeed)
+{
+	FILE *outfile;
+	char theFileName[256];
+	int  i;
+
+	if (strlen(tailFileName) > sizeof(theFileName) - 16 ||
+		(outfile = fopen(tailFileName, WRITETEXT)) == NULL)
+		return NOTOK;
+
+	qsort(tail, numTail, sizeof(tailRecord), CompareTailRecords);
+
+	fprintf(outfile, "# planarity -r -%c %d %d -seed %u -tail %d %s\n",
+			command, NumGraphs, theGraph->N, campaignSeed, numTail, tailFileName);
+	fprintf(outfile, "# Reproduce a graph with: planarity -r -%c 1 %d -seed SEED\n",
+			command, theGraph->N);
+	fprintf(outfile, "# rank graph seed latency_ns result initialize_ns edge_addition_ns "
+			"isolation_ns postprocess_ns extension_postprocess_ns walkup_hops "
+			"walkdown_iterations merge_bicomps_calls invert_vertex_flips "
+			"inactive_vertex_hops future_pertinent_child_advances blocked_bicomp_reentries\n");
+
+	for (i = 0; i < numTail; i++)
+	{
+		fprintf(outfile, "%d %d %u %llu %d %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu\n",
+				i+1, tail[i].graphNum, tail[i].seed, tail[i].latencyNs, tail[i].result,
+				tail[i].stats.initializeTime, tail[i].stats.edgeAdditionTime,
+				tail[i].stats.isolationTime, tail[i].stats.postprocessTime,
+				tail[i].stats.extensionPostprocessTime,
+				tail[i].stats.counters.walkUpHops, tail[i].stats.counters.walkDownIterations,
+				tail[i].stats.counters.mergeBicompsCalls, tail[i].stats.counters.invertVertexFlips,
+				tail[i].stats.counters.inactiveVertexHops,
+				tail[i].stats.counters.futurePertinentChildAdvances,
+				tail[i].stats.counters.blockedBicompReentries);
+
+		gp_ReinitializeGraph(theGraph);
+		srand(tail[i].seed);
+		sprintf(theFileName, "%s.%d.txt", tailFileName, i+1);
+		if (gp_CreateRandomGraph(theGraph) != OK ||
+			gp_Write(theGraph, theFileName, WRITE_ADJLIST) != OK)
+		{
+			fclose(outfile);
+			return NOTOK;
+		}
+	}
+
+	fclose(outfile);
+	return OK;
+}
+
 /****************************************************************************
  GetNumberIfZero()
  Internal function that gets a number if the given *pNum is zero.
@@ -329,7 +503,7 @@ graphP theGraph=NULL, origGraph;
 int embedFlags = GetEmbedFlags(command);
 char saveEdgeListFormat;
 
-     GetNumberIfZero(&numVertices, "Enter number of vertices:", 1, 1000000);
+     GetNumberIfZero(&numVertices, "Enter number of vertices:", 1, MAX_DEFAULT_N);
      if ((theGraph = MakeGraph(numVertices, command)) == NULL)
     	 return NOTOK;
 
@@ -0,0 +1,211 @@
+/*
+Copyright (c) 1997-2015, John M. Boyer
+All rights reserved.
+See the LICENSE.TXT file for licensing information.
+*/
+
+/****************************************************************************
+ planarity-trace
+
+ Records and decodes the binary trace files of the embedder (see
+ gp_EnableTrace() and gp_WriteTrace()).
+
+ 'planarity-trace -r C I O [K]' embeds the graph in input file I with the
+ algorithm C (-p, -d, -o, -2, -3 or -4), keeping the last K trace events
+ (default 65536), and writes them to the trace file O.  The library must
+ be built with EMBEDTRACE (cmake -DPLANARITY_EMBED_TRACE=ON).
+
+ 'planarity-trace O' decodes the trace file O to stdout, one event per
+ line, preceded by the sequence number of the event within the trace.
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graphK23Search.h"
+#include "graphK33Search.h"
+#include "graphK4Search.h"
+#include "graphDrawPlanar.h"
+#include "planarityAlgorithms.h"
+
+#define TRACE_DEFAULT_CAPACITY  65536
+
+int  trace_Record(char command, char *infileName, char *outfileName, int capacity);
+int  trace_Decode(char *traceFileName);
+void trace_WriteEvent(FILE *outfile, unsigned long long seq, traceEventP event);
+void trace_WriteMinorType(FILE *outfile, int minorType);
+
+/****************************************************************************
+ MAIN
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	if (argc >= 5 && argc <= 6 && strcmp(argv[1], "-r") == 0 && strlen(argv[2]) == 2)
+		return trace_Record(argv[2][1], argv[3], argv[4],
+				argc == 6 ? atoi(argv[5]) : TRACE_DEFAULT_CAPACITY) == OK ? 0 : 1;
+
+	if (argc == 2 && argv[1][0] != '-')
+		return trace_Decode(argv[1]) == OK ? 0 : 1;
+
+	fprintf(stderr, "Usage: planarity-trace -r C I O [K]  (record)\n"
+	                "       planarity-trace O             (decode)\n");
+	return 1;
+}
+
+/****************************************************************************
+ trace_Record()
+ ****************************************************************************/
+
+int  trace_Record(char command, char *infileName, char *outfileName, int capacity)
+{
+	graphP theGraph;
+	int Result, embedFlags = GetEmbedFlags(command);
+
+	if (embedFlags == 0 || capacity <= 0)
+	{
+		fprintf(stderr, "Unsupported algorithm or trace capacity\n");
+		return NOTOK;
+	}
+
+	if ((theGraph = gp_New()) == NULL ||
+		gp_Read(theGraph, infileName) != OK ||
+		AttachAlgorithm(theGraph, command) != OK)
+	{
+		fprintf(stderr, "Unable to read '%s'\n", infileName);
+		gp_Free(&theGraph);
+		return NOTOK;
+	}
+
+	if (gp_EnableTrace(theGraph, capacity) != OK)
+	{
+		fprintf(stderr, "Unable to enable tracing; the library must be built with EMBEDTRACE\n");
+		gp_Free(&theGraph);
+		return NOTOK;
+	}
+
+	Result = gp_Embed(theGraph, embedFlags);
+
+	if (gp_WriteTrace(theGraph, outfileName) != OK)
+	{
+		fprintf(stderr, "Unable to write '%s'\n", outfileName);
+		gp_Free(&theGraph);
+		return NOTOK;
+	}
+
+	gp_Free(&theGraph);
+	return Result == OK || Result == NONEMBEDDABLE ? OK : NOTOK;
+}
+
+/****************************************************************************
+ trace_Decode()
+ ****************************************************************************/
+
+int  trace_Decode(char *traceFileName)
+{
+	traceFileHeader header;
+	traceEvent event;
+	unsigned long long first;
+	unsigned int i;
+	FILE *infile;
+
+	if ((infile = fopen(traceFileName, "rb")) == NULL)
+	{
+		fprintf(stderr, "Unable to open '%s'\n", traceFileName);
+		return NOTOK;
+	}
+
+	if (fread(&header, sizeof(traceFileHeader), 1, infile) != 1 ||
+		header.magic != TRACEFILE_MAGIC || header.version != TRACEFILE_VERSION ||
+		header.eventSize != sizeof(traceEvent))
+	{
+		fprintf(stderr, "'%s' is not a trace file of this version and machine\n", traceFileName);
+		fclose(infile);
+		return NOTOK;
+	}
+
+	first = header.numEvents - header.numRecorded;
+	printf("# %llu events traced, the last %u of them kept (capacity %u)\n",
+			header.numEvents, header.numRecorded, header.capacity);
+
+	for (i = 0; i < header.numRecorded; i++)
+	{
+		if (fread(&event, sizeof(traceEvent), 1, infile) != 1)
+		{
+			fprintf(stderr, "'%s' is truncated after %u events\n", traceFileName, i);
+			fclose(infile);
+			return NOTOK;
+		}
+		trace_WriteEvent(stdout, first + i, &event);
+	}
+
+	fclose(infile);
+	return OK;
+}
+
+/****************************************************************************
+ trace_WriteEvent()
+ ****************************************************************************/
+
+void trace_WriteEvent(FILE *outfile, unsigned long long seq, traceEventP event)
+{
+	int *arg = event->arg;
+
+	fprintf(outfile, "%llu ", seq);
+
+	switch (event->type)
+	{
+		case TRACEEVENT_EMBEDSTART :
+			fprintf(outfile, "EmbedStart N=%d, embedFlags=%d\n", arg[0], arg[1]);
+			break;
+		case TRACEEVENT_VERTEXSTEP :
+			fprintf(outfile, "VertexStep v=%d\n", arg[0]);
+			break;
+		case TRACEEVENT_WALKDOWNDESCENT :
+			fprintf(outfile, "WalkdownDescent v=%d, W=%d, R=%d\n", arg[0], arg[1], arg[2]);
+			break;
+		case TRACEEVENT_EMBEDBACKEDGE :
+			fprintf(outfile, "EmbedBackEdge V=%d, R=%d, R_out=%d, W=%d\n", arg[0], arg[1], arg[2], arg[3]);
+			break;
+		case TRACEEVENT_MERGEVERTEX :
+			fprintf(outfile, "MergeVertex W=%d, W_in=%d, R=%d, R_out=%d\n", arg[0], arg[1], arg[2], arg[3]);
+			break;
+		case TRACEEVENT_INVERTVERTEX :
+			fprintf(outfile, "InvertVertex W=%d\n", arg[0]);
+			break;
+		case TRACEEVENT_MINORCHOSEN :
+			fprintf(outfile, "MinorChosen v=%d, R=%d, W=%d, minor=", arg[0], arg[1], arg[2]);
+			trace_WriteMinorType(outfile, arg[3]);
+			break;
+		case TRACEEVENT_EMBEDEND :
+			fprintf(outfile, "EmbedEnd result=%s\n", arg[0] == OK ? "OK" :
+					(arg[0] == NONEMBEDDABLE ? "NONEMBEDDABLE" : "NOTOK"));
+			break;
+		default :
+			fprintf(outfile, "Unknown type=%d, %d, %d, %d, %d\n", event->type, arg[0], arg[1], arg[2], arg[3]);
+			break;
+	}
+}
+
+/****************************************************************************
+ trace_WriteMinorType()
+ Writes the names of the minor flags set in minorType, e.g. "C+E1".
+ ****************************************************************************/
+
+void trace_WriteMinorType(FILE *outfile, int minorType)
+{
+	static char *minorNames[] = {
+			"A", "B", "C", "D", "E", "E1", "E2", "E3", "E4", "E5", "E6", "E7"
+	};
+	int i, numWritten = 0;
+
+	for (i = 0; i < (int) (sizeof(minorNames) / sizeof(minorNames[0])); i++)
+	{
+		if (minorType & (1 << i))
+			fprintf(outfile, numWritten++ ? "+%s" : "%s", minorNames[i]);
+	}
+
+	fprintf(outfile, numWritten ? "\n" : "none\n");
+}
@@ -125,8 +125,22 @@ void SaveAsciiGraph(graphP theGraph, char *filename)
 }
 
 /****************************************************************************
+ FilesEqual()
+ Compares the two files character by character, except that carriage
+ returns are skipped so that exemplar files with CR/LF line endings
+ compare equal to results written with LF line endings.
  ****************************************************************************/
 
+int  fgetcSkipCR(FILE *infile)
+{
+	int c;
+
+	while ((c = fgetc(infile)) == '\r')
+		;
+
+	return c;
+}
+
 int  FilesEqual(char *file1Name, char *file2Name)
 {
 	FILE *infile1 = NULL, *infile2 = NULL;
@@ -142,11 +156,11 @@ int  FilesEqual(char *file1Name, char *file2Name)
 		int c1=0, c2=0;
 
 		// Read the first file to the end
-		while ((c1 = fgetc(infile1)) != EOF)
+		while ((c1 = fgetcSkipCR(infile1)) != EOF)
 		{
 			// If we got a char from the first file, but not from the second
 			// then the second file is shorter, so files are not equal
-			if ((c2 = fgetc(infile2)) == EOF)
+			if ((c2 = fgetcSkipCR(infile2)) == EOF)
 			{
 				Result = FALSE;
 				break;
@@ -165,7 +179,7 @@ int  FilesEqual(char *file1Name, char *file2Name)
 		if (c1 == EOF)
 		{
 			// Then attempt to read from the second file to ensure it also ends.
-			if (fgetc(infile2) != EOF)
+			if (fgetcSkipCR(infile2) != EOF)
 				Result = FALSE;
 		}
 	}
@@ -175,60 +189,6 @@ int  FilesEqual(char *file1Name, char *file2Name)
 	return Result;
 }
 
-/****************************************************************************
- ****************************************************************************/
-
-int GetEmbedFlags(char command)
-{
-	int embedFlags = 0;
-
-	switch (command)
-	{
-		case 'o' : embedFlags = EMBEDFLAGS_OUTERPLANAR; break;
-		case 'p' : embedFlags = EMBEDFLAGS_PLANAR; break;
-		case 'd' : embedFlags = EMBEDFLAGS_DRAWPLANAR; break;
-		case '2' : embedFlags = EMBEDFLAGS_SEARCHFORK23; break;
-		case '3' : embedFlags = EMBEDFLAGS_SEARCHFORK33; break;
-		case '4' : embedFlags = EMBEDFLAGS_SEARCHFORK4; break;
-	}
-
-	return embedFlags;
-}
-
-/****************************************************************************
- ****************************************************************************/
-
-char *GetAlgorithmName(char command)
-{
-	char *algorithmName = "UnsupportedAlgorithm";
-
-	switch (command)
-	{
-		case 'p' : algorithmName = "PlanarEmbed"; break;
-		case 'd' : algorithmName = DRAWPLANAR_NAME;	break;
-		case 'o' : algorithmName = "OuterplanarEmbed"; break;
-		case '2' : algorithmName = K23SEARCH_NAME; break;
-		case '3' : algorithmName = K33SEARCH_NAME; break;
-		case '4' : algorithmName = K4SEARCH_NAME; break;
-	}
-
-	return algorithmName;
-}
-
-/****************************************************************************
- ****************************************************************************/
-
-void AttachAlgorithm(graphP theGraph, char command)
-{
-	switch (command)
-	{
-		case 'd' : gp_AttachDrawPlanar(theGraph); break;
-		case '2' : gp_AttachK23Search(theGraph); break;
-		case '3' : gp_AttachK33Search(theGraph); break;
-		case '4' : gp_AttachK4Search(theGraph); break;
-	}
-}
-
 /****************************************************************************
  A string used to construct input and output filenames.
 
@@ -16,6 +16,17 @@ See the LICENSE.TXT file for licensing information.
 #define platform_GetTime(timeVar) (timeVar = GetTickCount())
 #define platform_GetDuration(startTime, endTime) ((double) (endTime-startTime) / 1000.0)
 
+// Monotonic nanosecond time stamps for fine-grained timing, e.g. of embedder phases
+
+static __inline unsigned long long platform_GetTimeNs(void)
+{
+	LARGE_INTEGER count, frequency;
+
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&frequency);
+	return (unsigned long long) ((double) count.QuadPart * 1e9 / (double) frequency.QuadPart);
+}
+
 #else
 
 #include <time.h>
@@ -36,6 +47,16 @@ typedef struct {
 		( (double) (endTime.lowresTime - startTime.lowresTime) ) : \
 		( (double) (endTime.hiresTime - startTime.hiresTime)) / CLOCKS_PER_SEC)
 
+// Monotonic nanosecond time stamps for fine-grained timing, e.g. of embedder phases
+
+static inline unsigned long long platform_GetTimeNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long) ts.tv_sec * 1000000000ULL + (unsigned long long) ts.tv_nsec;
+}
+
 /*
 #define platform_time clock_t
 #define platform_GetTime() clock()
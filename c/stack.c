@@ -8,7 +8,7 @@ See the LICENSE.TXT file for licensing information.
 #include "stack.h"
 #include <stdlib.h>
 
-stackP sp_New(int capacity)
+stackP sp_New(stackIndex capacity)
 {
 stackP theStack;
 
@@ -33,6 +33,28 @@ stackP theStack;
      return theStack;
 }
 
+/* Constructs a stack in the sp_SizeOf(capacity) bytes of memory given by
+   the caller, who remains its owner, so sp_Free() must not be used. */
+
+stackP sp_NewAt(void *memory, stackIndex capacity)
+{
+stackP theStack = (stackP) memory;
+
+     if (theStack != NULL)
+     {
+         theStack->S = (int *) (theStack + 1);
+         theStack->capacity = capacity;
+         sp_ClearStack(theStack);
+     }
+
+     return theStack;
+}
+
+size_t sp_SizeOf(stackIndex capacity)
+{
+     return sizeof(stack) + capacity * sizeof(int);
+}
+
 void sp_Free(stackP *pStack)
 {
      if (pStack == NULL || *pStack == NULL) return;
@@ -47,6 +69,13 @@ void sp_Free(stackP *pStack)
      *pStack = NULL;
 }
 
+size_t sp_GetMemoryUsage(stackP theStack)
+{
+     if (theStack == NULL) return 0;
+
+     return sizeof(stack) + theStack->capacity * sizeof(int);
+}
+
 int  sp_CopyContent(stackP stackDst, stackP stackSrc)
 {
      if (stackDst->capacity < stackSrc->size)
@@ -106,12 +135,12 @@ int  sp_ClearStack(stackP theStack)
      return OK;
 }
 
-int  sp_GetCurrentSize(stackP theStack)
+stackIndex sp_GetCurrentSize(stackP theStack)
 {
      return theStack->size;
 }
 
-int  sp_SetCurrentSize(stackP theStack, int size)
+int  sp_SetCurrentSize(stackP theStack, stackIndex size)
 {
 	 return size > theStack->capacity ? NOTOK : (theStack->size = size, OK);
 }
@@ -170,7 +199,7 @@ int  sp_Top(stackP theStack)
     return theStack->size ? theStack->S[theStack->size-1] : NIL;
 }
 
-int  sp_Get(stackP theStack, int pos)
+int  sp_Get(stackP theStack, stackIndex pos)
 {
 	 if (theStack == NULL || pos < 0 || pos >= theStack->size)
 		 return NOTOK;
@@ -178,7 +207,7 @@ int  sp_Get(stackP theStack, int pos)
      return (theStack->S[pos]);
 }
 
-int  sp_Set(stackP theStack, int pos, int val)
+int  sp_Set(stackP theStack, stackIndex pos, int val)
 {
 	 if (theStack == NULL || pos < 0 || pos >= theStack->size)
 		 return NOTOK;
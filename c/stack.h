@@ -14,16 +14,25 @@ extern "C" {
 // includes mem functions like memcpy
 #include <string.h>
 
+/* The type of the size and capacity of a stack, and of positions in it.
+   It is wider than int because the stack of a graph holds two integers
+   per arc, so it can outgrow the int range before the graph's indices do. */
+
+typedef long long stackIndex;
+
 typedef struct
 {
         int *S;
-        int size, capacity;
+        stackIndex size, capacity;
 } stack;
 
 typedef stack * stackP;
 
-stackP sp_New(int);
+stackP sp_New(stackIndex capacity);
+stackP sp_NewAt(void *memory, stackIndex capacity);
+size_t sp_SizeOf(stackIndex capacity);
 void sp_Free(stackP *);
+size_t sp_GetMemoryUsage(stackP theStack);
 
 int  sp_Copy(stackP, stackP);
 
@@ -35,8 +44,8 @@ stackP sp_Duplicate(stackP theStack);
 #ifndef SPEED_MACROS
 
 int  sp_ClearStack(stackP);
-int  sp_GetCurrentSize(stackP theStack);
-int  sp_SetCurrentSize(stackP theStack, int top);
+stackIndex sp_GetCurrentSize(stackP theStack);
+int  sp_SetCurrentSize(stackP theStack, stackIndex top);
 
 int  sp_IsEmpty(stackP);
 int  sp_NonEmpty(stackP);
@@ -54,8 +63,8 @@ int  sp__Pop(stackP, int *);
 int  sp__Pop2(stackP, int *, int *);
 
 int  sp_Top(stackP);
-int  sp_Get(stackP, int);
-int  sp_Set(stackP, int, int);
+int  sp_Get(stackP, stackIndex);
+int  sp_Set(stackP, stackIndex, int);
 
 #else
 
@@ -0,0 +1,41 @@
+# Training run for a profile-guided optimization build of planarity.
+#
+# Invoked by the pgo-train target of a build configured with
+# PLANARITY_PGO=GENERATE.  It exercises every algorithm of the command line
+# on the built-in random graph workloads (-r, -rm, -rn) and on the
+# planarity-bench workload families, so that the profile covers the Walkup,
+# Walkdown, bicomp merging and the obstruction isolators of each extension.
+#
+# Expects PLANARITY, PLANARITY_BENCH and WORK_DIR to be defined.
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+# -rm and -rn ask whether to save the graph in edge list format
+file(WRITE ${WORK_DIR}/answers.txt "n\n")
+
+function(planarity_pgo_run)
+    execute_process(COMMAND ${ARGN}
+        WORKING_DIRECTORY ${WORK_DIR}
+        INPUT_FILE ${WORK_DIR}/answers.txt
+        RESULT_VARIABLE result
+        OUTPUT_QUIET)
+    # The command line returns 1 for nonplanar results, which is expected
+    # here; only a failure to run or an error result (-1) stops the training.
+    if(NOT result MATCHES "^[01]$")
+        message(FATAL_ERROR "planarity PGO training step failed (${result}): ${ARGN}")
+    endif()
+endfunction()
+
+foreach(command p d o 2 3 4)
+    message(STATUS "Training on random graphs for -${command}")
+    planarity_pgo_run(${PLANARITY} -r -q -${command} 1000 1000)
+endforeach()
+
+message(STATUS "Training on maximal planar and nonplanar random graphs")
+foreach(size 10000 100000)
+    planarity_pgo_run(${PLANARITY} -rm -q ${size} maxplanar.out)
+    planarity_pgo_run(${PLANARITY} -rn -q ${size} nonplanar.out obstruction.out)
+endforeach()
+
+message(STATUS "Training on the planarity-bench workload families")
+planarity_pgo_run(${PLANARITY_BENCH} -n 1000,10000 -t 5 -w 0 -o bench_train.json)